@@ -49,6 +49,12 @@ const bool Burst::Settings::Avx2 = true;
 const bool Burst::Settings::Avx2 = false;
 #endif
 
+#ifdef USE_AVX512
+const bool Burst::Settings::Avx512 = true;
+#else
+const bool Burst::Settings::Avx512 = false;
+#endif
+
 #ifdef USE_CUDA
 const bool Burst::Settings::Cuda = true;
 #else
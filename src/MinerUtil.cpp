@@ -57,9 +57,19 @@
 #include <sys/types.h>
 #include <sys/param.h>
 #include <termios.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <climits>
+#include <cstdlib>
 #if defined(BSD)
 #include <sys/sysctl.h>
 #endif
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/sysmacros.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
 
 #endif
 
@@ -927,6 +937,7 @@ bool Burst::cpuHasInstructionSet(CpuInstructionSet cpuInstructionSet)
 	case sse4: return (instructionSets & sse4) == sse4;
 	case avx: return (instructionSets & avx) == avx;
 	case avx2: return (instructionSets & avx2) == avx2;
+	case avx512f: return (instructionSets & avx512f) == avx512f;
 	default: return false;
 	}
 }
@@ -950,6 +961,9 @@ int Burst::cpuGetInstructionSets()
 	if (__builtin_cpu_supports("avx2"))
 		instruction_sets += avx2;
 
+	if (__builtin_cpu_supports("avx512f"))
+		instruction_sets += avx512f;
+
 	return instruction_sets;
 #else
 	int info[4];
@@ -960,6 +974,7 @@ int Burst::cpuGetInstructionSets()
 	auto has_sse4 = false;
 	auto has_avx = false;
 	auto has_avx2 = false;
+	auto has_avx512f = false;
 
 	//  Detect Features
 	if (n_ids >= 0x00000001)
@@ -974,6 +989,7 @@ int Burst::cpuGetInstructionSets()
 	{
 		cpuid(info, 0x00000007);
 		has_avx2 = (info[1] & (static_cast<int>(1) << 5)) != 0;
+		has_avx512f = (info[1] & (static_cast<int>(1) << 16)) != 0;
 	}
 
 	auto instruction_sets = 0;
@@ -990,6 +1006,9 @@ int Burst::cpuGetInstructionSets()
 	if (has_avx2)
 		instruction_sets += avx2;
 
+	if (has_avx512f)
+		instruction_sets += avx512f;
+
 	return instruction_sets;
 #endif
 }
@@ -1100,6 +1119,84 @@ void Burst::setStdInEcho(bool enable)
 #endif
 }
 
+std::string Burst::getDeviceOfPath(const std::string& path)
+{
+#if defined(_WIN32)
+	char volume[MAX_PATH];
+
+	if (!GetVolumePathNameA(path.c_str(), volume, MAX_PATH))
+		return "";
+
+	return volume;
+#elif defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+	struct stat status;
+
+	if (stat(path.c_str(), &status) != 0)
+		return "";
+
+#if defined(__linux__)
+	const auto device = std::to_string(major(status.st_dev)) + ":" + std::to_string(minor(status.st_dev));
+	char blockDevice[PATH_MAX];
+
+	// /sys/dev/block/<major>:<minor> links to the block device (../block/sda/sda1 for a partition)
+	if (realpath(("/sys/dev/block/" + device).c_str(), blockDevice) == nullptr)
+		return device;
+
+	std::string blockDevicePath = blockDevice;
+
+	// a partition, the disk is the parent
+	if (Poco::File{blockDevicePath + "/partition"}.exists())
+		blockDevicePath = blockDevicePath.substr(0, blockDevicePath.find_last_of('/'));
+
+	return blockDevicePath.substr(blockDevicePath.find_last_of('/') + 1);
+#else
+	return std::to_string(status.st_dev);
+#endif
+#else
+	return "";
+#endif
+}
+
+bool Burst::getPhysicalOffsetOfFile(const std::string& path, Poco::UInt64& offset, Poco::UInt64& index)
+{
+	offset = 0;
+	index = 0;
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || (defined(__APPLE__) && defined(__MACH__))
+	const auto file = open(path.c_str(), O_RDONLY);
+
+	if (file < 0)
+		return false;
+
+	struct stat status;
+
+	if (fstat(file, &status) == 0)
+		index = status.st_ino;
+
+	auto physical = false;
+
+#if defined(__linux__)
+	// we only need the first extent of the file
+	char buffer[sizeof(fiemap) + sizeof(fiemap_extent)] = {};
+	auto extentMap = reinterpret_cast<fiemap*>(buffer);
+	extentMap->fm_start = 0;
+	extentMap->fm_length = FIEMAP_MAX_OFFSET;
+	extentMap->fm_extent_count = 1;
+
+	if (ioctl(file, FS_IOC_FIEMAP, extentMap) == 0 && extentMap->fm_mapped_extents > 0)
+	{
+		offset = extentMap->fm_extents[0].fe_physical;
+		physical = true;
+	}
+#endif
+
+	close(file);
+	return physical;
+#else
+	return false;
+#endif
+}
+
 Poco::Path Burst::getMinerHomeDir()
 {
 	Poco::Path minerRootPath(Poco::Path::home());
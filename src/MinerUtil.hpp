@@ -93,7 +93,8 @@ namespace Burst
 		sse2 = 1 << 0,
 		sse4 = 1 << 1,
 		avx = 1 << 2,
-		avx2 = 1 << 3
+		avx2 = 1 << 3,
+		avx512f = 1 << 4
 	};
 
 	bool isNumberStr(const std::string& str);
@@ -174,6 +175,23 @@ namespace Burst
 	size_t getMemorySize();
 	void setStdInEcho(bool enable);
 
+	/**
+	 * \brief Returns a name of the physical device, a file or directory is stored on.
+	 * Partitions of the same disk return the same name.
+	 * \param path The path of the file or directory.
+	 * \return The name of the device (the disk on Linux, the volume on Windows) or an empty string, if unknown.
+	 */
+	std::string getDeviceOfPath(const std::string& path);
+
+	/**
+	 * \brief Returns the physical position of a file on its device.
+	 * \param path The path of the file.
+	 * \param offset The physical offset of the first block of the file (only Linux).
+	 * \param index The index of the file inside the file system (inode), can be used instead of the offset.
+	 * \return true, if the physical offset is known.
+	 */
+	bool getPhysicalOffsetOfFile(const std::string& path, Poco::UInt64& offset, Poco::UInt64& index);
+
 	Poco::Path getMinerHomeDir();
 	Poco::Path getMinerHomeDir(const std::string& filename);
 }
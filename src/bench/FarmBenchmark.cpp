@@ -0,0 +1,160 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "FarmBenchmark.hpp"
+#include "SyntheticFarm.hpp"
+#include "MockPool.hpp"
+#include "mining/Miner.hpp"
+#include "mining/MinerConfig.hpp"
+#include "logging/MinerLogger.hpp"
+#include "MinerUtil.hpp"
+#include <Poco/FileStream.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/Path.h>
+#include <Poco/String.h>
+#include <random>
+#include <thread>
+
+const Poco::UInt64 Burst::FarmBenchmark::StartHeight = 600000;
+const Poco::UInt64 Burst::FarmBenchmark::BaseTarget = 50000;
+
+double Burst::FarmBenchmark::Round::getScoopsPerSecond() const
+{
+	return seconds > 0 ? scoops / seconds : 0;
+}
+
+double Burst::FarmBenchmark::Round::getBytesPerSecond() const
+{
+	return getScoopsPerSecond() * Settings::ScoopSize;
+}
+
+Burst::FarmBenchmark::FarmBenchmark(const SyntheticFarm& farm, MockPool& pool)
+	: farm_{&farm},
+	  pool_{&pool}
+{}
+
+bool Burst::FarmBenchmark::configure(const std::string& processorType, const std::string& cpuInstructionSet) const
+{
+	Poco::Path configPath{farm_->getDir()};
+	configPath.makeDirectory();
+
+	auto databasePath = configPath;
+	databasePath.setFileName("bench.db");
+	configPath.setFileName("bench.conf");
+
+	Poco::JSON::Object::Ptr urls(new Poco::JSON::Object);
+	urls->set("submission", pool_->getUrl());
+	urls->set("miningInfo", pool_->getUrl());
+	urls->set("wallet", pool_->getUrl());
+
+	Poco::JSON::Array::Ptr plots(new Poco::JSON::Array);
+	plots->add(farm_->getDir());
+
+	Poco::JSON::Object::Ptr mining(new Poco::JSON::Object);
+	mining->set("urls", urls);
+	mining->set("plots", plots);
+	mining->set("processorType", processorType);
+	mining->set("cpuInstructionSet", cpuInstructionSet);
+	mining->set("databasePath", databasePath.toString());
+	mining->set("getMiningInfoInterval", 1);
+
+	Poco::JSON::Object::Ptr logging(new Poco::JSON::Object);
+	logging->set("logfile", false);
+
+	Poco::JSON::Object::Ptr webserver(new Poco::JSON::Object);
+	webserver->set("start", false);
+
+	Poco::JSON::Object config;
+	config.set("mining", mining);
+	config.set("logging", logging);
+	config.set("webserver", webserver);
+
+	try
+	{
+		Poco::FileOutputStream stream{configPath.toString()};
+		config.stringify(stream, 4);
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::general, "Could not write the config of the benchmark: %s", exc.displayText());
+		return false;
+	}
+
+	return MinerConfig::getConfig().readConfigFile(configPath.toString()) == ReadConfigFileResult::Ok;
+}
+
+std::vector<Burst::FarmBenchmark::Round> Burst::FarmBenchmark::run(const size_t blocks, const std::chrono::seconds timeout) const
+{
+	std::vector<Round> rounds;
+	std::mt19937 random{42};
+
+	Miner miner;
+	std::thread minerThread{[&miner]() { miner.run(); }};
+
+	for (size_t i = 0; i < blocks; ++i)
+	{
+		Round round;
+		round.height = StartHeight + i;
+		round.scoops = farm_->getNonces();
+
+		std::string gensig;
+
+		for (size_t j = 0; j < Settings::HashSize; ++j)
+			gensig += Poco::NumberFormatter::formatHex(random() & 0xFF, 2);
+
+		const auto submissions = pool_->getSubmissions();
+		pool_->setBlock(round.height, Poco::toLower(gensig), BaseTarget);
+
+		const auto startPoint = std::chrono::steady_clock::now();
+
+		while (std::chrono::steady_clock::now() - startPoint < timeout)
+		{
+			const auto block = miner.getData().getBlockData();
+
+			if (block != nullptr && block->getBlockheight() == round.height && block->getRoundTime() > 0)
+			{
+				round.seconds = block->getRoundTime();
+				round.finished = true;
+				break;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds{100});
+		}
+
+		round.submissions = pool_->getSubmissions() - submissions;
+
+		if (round.finished)
+			log_information(MinerLogger::general, "Round %s of the benchmark: %ss, %s/s",
+				numberToString(i + 1), Poco::NumberFormatter::format(round.seconds, 3),
+				memToString(static_cast<Poco::UInt64>(round.getBytesPerSecond()), 2));
+		else
+			log_error(MinerLogger::general, "Round %s of the benchmark did not finish in time", numberToString(i + 1));
+
+		rounds.emplace_back(round);
+	}
+
+	miner.stop();
+	minerThread.join();
+
+	return rounds;
+}
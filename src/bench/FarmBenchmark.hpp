@@ -0,0 +1,85 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	class SyntheticFarm;
+	class MockPool;
+
+	/**
+	 * \brief Runs the miner on a synthetic farm against a mock pool and measures every round.
+	 */
+	class FarmBenchmark
+	{
+	public:
+		struct Round
+		{
+			Poco::UInt64 height = 0;
+			double seconds = 0.0;
+			Poco::UInt64 scoops = 0;
+			Poco::UInt64 submissions = 0;
+			bool finished = false;
+
+			double getScoopsPerSecond() const;
+			double getBytesPerSecond() const;
+		};
+
+		FarmBenchmark(const SyntheticFarm& farm, MockPool& pool);
+
+		/**
+		 * \brief Writes and loads a miner config, that mines the farm at the mock pool.
+		 * \param processorType The processor type of the verifiers (CPU, CUDA, OPENCL, SIMULATED_GPU).
+		 * \param cpuInstructionSet The cpu instruction set or AUTO.
+		 * \return true, if the config was loaded.
+		 */
+		bool configure(const std::string& processorType, const std::string& cpuInstructionSet) const;
+
+		/**
+		 * \brief Mines a number of blocks, one after another.
+		 * A block is only set at the pool, when the round of the previous one is finished.
+		 * \param blocks The amount of blocks.
+		 * \param timeout The maximal time of a round.
+		 * \return The measurement of every round.
+		 */
+		std::vector<Round> run(size_t blocks, std::chrono::seconds timeout) const;
+
+		/**
+		 * \brief The height of the first block, it is after the PoC2 fork.
+		 */
+		static const Poco::UInt64 StartHeight;
+
+		/**
+		 * \brief A base target of the size, that is common on the network.
+		 */
+		static const Poco::UInt64 BaseTarget;
+
+	private:
+		const SyntheticFarm* farm_;
+		MockPool* pool_;
+	};
+}
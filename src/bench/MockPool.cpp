@@ -0,0 +1,146 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "MockPool.hpp"
+#include "webserver/RequestHandler.hpp"
+#include "network/Request.hpp"
+#include "logging/MinerLogger.hpp"
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/URI.h>
+#include <sstream>
+
+Burst::MockPool::MockPool() = default;
+
+Burst::MockPool::~MockPool()
+{
+	stop();
+}
+
+bool Burst::MockPool::start(const Poco::UInt16 port)
+{
+	using namespace Poco::Net;
+
+	try
+	{
+		const ServerSocket socket{SocketAddress{"127.0.0.1", port}};
+		port_ = socket.address().port();
+
+		auto params = new HTTPServerParams;
+		params->setMaxThreads(4);
+
+		threadPool_.addCapacity(4);
+		server_ = std::make_unique<HTTPServer>(new RequestFactory{*this}, threadPool_, socket, params);
+		server_->start();
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::general, "Could not start the mock pool: %s", exc.displayText());
+		server_.reset();
+		return false;
+	}
+
+	log_information(MinerLogger::general, "Mock pool is running on %s", getUrl());
+	return true;
+}
+
+void Burst::MockPool::stop()
+{
+	if (server_ != nullptr)
+	{
+		server_->stopAll(true);
+		threadPool_.stopAll();
+		server_.reset();
+	}
+}
+
+std::string Burst::MockPool::getUrl() const
+{
+	return "http://127.0.0.1:" + std::to_string(port_);
+}
+
+void Burst::MockPool::setBlock(const Poco::UInt64 height, const std::string& gensig, const Poco::UInt64 baseTarget)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	height_ = height;
+	gensig_ = gensig;
+	baseTarget_ = baseTarget;
+}
+
+Poco::UInt64 Burst::MockPool::getSubmissions() const
+{
+	return submissions_.load();
+}
+
+std::string Burst::MockPool::getMiningInfo() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	Poco::JSON::Object json;
+	json.set("height", std::to_string(height_));
+	json.set("generationSignature", gensig_);
+	json.set("baseTarget", std::to_string(baseTarget_));
+	json.set("targetDeadline", 31536000);
+
+	std::stringstream sstream;
+	json.stringify(sstream);
+	return sstream.str();
+}
+
+Burst::MockPool::RequestFactory::RequestFactory(MockPool& pool)
+	: pool{&pool}
+{}
+
+Poco::Net::HTTPRequestHandler* Burst::MockPool::RequestFactory::createRequestHandler(const Poco::Net::HTTPServerRequest& request)
+{
+	using req_t = Poco::Net::HTTPServerRequest;
+	using res_t = Poco::Net::HTTPServerResponse;
+
+	return new RequestHandler::LambdaRequestHandler([this](req_t& req, res_t& res)
+	{
+		std::string requestType;
+
+		for (const auto& parameter : Poco::URI{req.getURI()}.getQueryParameters())
+			if (parameter.first == "requestType")
+				requestType = parameter.second;
+
+		std::string body;
+
+		if (requestType == "getMiningInfo")
+			body = pool->getMiningInfo();
+		// every deadline is confirmed, the pool trusts the miner
+		else if (requestType == "submitNonce")
+		{
+			++pool->submissions_;
+			body = R"({ "result" : "success", "deadline" : )" + req.get(X_Deadline, "0") + " }";
+		}
+		else
+			body = R"({ "errorCode" : 1, "errorDescription" : "Unsupported request" })";
+
+		res.setContentType("application/json");
+		res.setContentLength(body.size());
+		res.send() << body;
+	});
+}
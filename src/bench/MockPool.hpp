@@ -0,0 +1,97 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <Poco/ThreadPool.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Poco
+{
+	namespace Net
+	{
+		class HTTPServer;
+	}
+}
+
+namespace Burst
+{
+	/**
+	 * \brief A local pool for benchmarks, that answers the mining info and the nonce submissions of the miner.
+	 * The blocks are set from the outside and every submitted deadline is confirmed.
+	 */
+	class MockPool
+	{
+	public:
+		MockPool();
+		~MockPool();
+
+		/**
+		 * \brief Starts the http server on the loopback interface.
+		 * \param port The port or 0 for any free port.
+		 * \return true, if the server is running.
+		 */
+		bool start(Poco::UInt16 port = 0);
+		void stop();
+
+		/**
+		 * \brief Returns the url of the pool (http://127.0.0.1:port).
+		 */
+		std::string getUrl() const;
+
+		/**
+		 * \brief Sets the block, that is returned as the mining info from now on.
+		 * \param height The height of the block.
+		 * \param gensig The gensig as a hex string.
+		 * \param baseTarget The base target of the block.
+		 */
+		void setBlock(Poco::UInt64 height, const std::string& gensig, Poco::UInt64 baseTarget);
+
+		/**
+		 * \brief Returns the amount of submitted nonces.
+		 */
+		Poco::UInt64 getSubmissions() const;
+
+	private:
+		struct RequestFactory : Poco::Net::HTTPRequestHandlerFactory
+		{
+			explicit RequestFactory(MockPool& pool);
+			Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& request) override;
+
+			MockPool* pool;
+		};
+
+		std::string getMiningInfo() const;
+
+		Poco::UInt16 port_ = 0;
+		Poco::UInt64 height_ = 0, baseTarget_ = 0;
+		std::string gensig_;
+		std::atomic<Poco::UInt64> submissions_{0};
+		mutable std::mutex mutex_;
+		Poco::ThreadPool threadPool_;
+		std::unique_ptr<Poco::Net::HTTPServer> server_;
+	};
+}
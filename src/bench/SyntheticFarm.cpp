@@ -0,0 +1,110 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "SyntheticFarm.hpp"
+#include "plots/PlotWriter.hpp"
+#include "plots/PlotReadBackend.hpp"
+#include "logging/MinerLogger.hpp"
+#include "MinerUtil.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+Burst::SyntheticFarm::SyntheticFarm(std::string dir, const Poco::UInt64 account, const size_t files,
+	const Poco::UInt64 noncesPerFile)
+	: dir_{std::move(dir)},
+	  account_{account},
+	  noncesPerFile_{noncesPerFile}
+{
+	for (size_t i = 0; i < files; ++i)
+	{
+		Poco::Path path{dir_};
+		path.makeDirectory();
+		path.setFileName(PlotWriter::getFileName(account_, i * noncesPerFile_, noncesPerFile_));
+		files_.emplace_back(path.toString());
+	}
+}
+
+bool Burst::SyntheticFarm::create(const bool generate, const std::string& instructionSet, const size_t threads)
+{
+	try
+	{
+		Poco::File{dir_}.createDirectories();
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::general, "Could not create the directory %s of the synthetic farm: %s", dir_, exc.displayText());
+		return false;
+	}
+
+	for (size_t i = 0; i < files_.size(); ++i)
+		if (!createFile(files_[i], i * noncesPerFile_, generate, instructionSet, threads))
+			return false;
+
+	return true;
+}
+
+const std::string& Burst::SyntheticFarm::getDir() const
+{
+	return dir_;
+}
+
+const std::vector<std::string>& Burst::SyntheticFarm::getFiles() const
+{
+	return files_;
+}
+
+Poco::UInt64 Burst::SyntheticFarm::getNonces() const
+{
+	return noncesPerFile_ * files_.size();
+}
+
+bool Burst::SyntheticFarm::createFile(const std::string& path, const Poco::UInt64 startNonce, const bool generate,
+	const std::string& instructionSet, const size_t threads) const
+{
+	// the plot writer continues interrupted files by itself
+	if (generate)
+	{
+		PlotWriter writer{dir_, account_, startNonce, noncesPerFile_};
+		writer.setInstructionSet(instructionSet);
+		writer.setThreads(threads);
+		return writer.run();
+	}
+
+	const auto fileSize = noncesPerFile_ * Settings::PlotSize;
+	Poco::File file{path};
+
+	if (file.exists() && file.getSize() == fileSize)
+	{
+		log_information(MinerLogger::general, "Using the existing plot file %s", path);
+		return true;
+	}
+
+	const PlotFileHandle handle{path, false, true};
+
+	if (!handle.isOpen() || !handle.resize(fileSize))
+	{
+		log_error(MinerLogger::general, "Could not create the plot file %s", path);
+		return false;
+	}
+
+	log_information(MinerLogger::general, "Created the sparse plot file %s (%s)", path, memToString(fileSize, 2));
+	return true;
+}
@@ -0,0 +1,72 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	/**
+	 * \brief A plot farm for benchmarks, that is created in a directory instead of being plotted on real disks.
+	 * The plot files are optimized PoC2 files with valid names (account_startnonce_nonces).
+	 */
+	class SyntheticFarm
+	{
+	public:
+		/**
+		 * \param dir The directory of the plot files.
+		 * \param account The account id of the plot files.
+		 * \param files The amount of plot files.
+		 * \param noncesPerFile The amount of nonces in every plot file.
+		 */
+		SyntheticFarm(std::string dir, Poco::UInt64 account, size_t files, Poco::UInt64 noncesPerFile);
+
+		/**
+		 * \brief Creates the plot files, that are missing or have the wrong size.
+		 * \param generate If true, the nonces are generated, so the deadlines are valid.
+		 * Otherwise the files are sparse files, that are read without touching the disk.
+		 * \param instructionSet The instruction set of the plot generator.
+		 * \param threads The amount of threads, that generate nonces.
+		 * \return true, if all files exist.
+		 */
+		bool create(bool generate, const std::string& instructionSet, size_t threads);
+
+		const std::string& getDir() const;
+		const std::vector<std::string>& getFiles() const;
+
+		/**
+		 * \brief Returns the amount of nonces of all plot files.
+		 */
+		Poco::UInt64 getNonces() const;
+
+	private:
+		bool createFile(const std::string& path, Poco::UInt64 startNonce, bool generate, const std::string& instructionSet,
+			size_t threads) const;
+
+		std::string dir_;
+		Poco::UInt64 account_;
+		Poco::UInt64 noncesPerFile_;
+		std::vector<std::string> files_;
+	};
+}
@@ -0,0 +1,566 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "plots/VerifierBenchmark.hpp"
+#include "SyntheticFarm.hpp"
+#include "MockPool.hpp"
+#include "FarmBenchmark.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/MinerCL.hpp"
+#include "gpu/impl/gpu_cuda_impl.hpp"
+#include "Declarations.hpp"
+#include <Poco/Util/OptionSet.h>
+#include <Poco/Util/OptionProcessor.h>
+#include <Poco/Util/HelpFormatter.h>
+#include <Poco/Util/Validator.h>
+#include <Poco/JSON/Array.h>
+#include <Poco/JSON/Object.h>
+#include <Poco/NumberParser.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/StringTokenizer.h>
+#include <Poco/String.h>
+#include <Poco/FileStream.h>
+#include <Poco/Data/SQLite/Connector.h>
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+struct Arguments
+{
+	Arguments();
+	bool process(int argc, const char* argv[]);
+
+	bool helpRequested = false;
+	std::string mode = "all";
+	std::string format = "csv";
+	std::string outputPath;
+	std::string gpu;
+	unsigned gpuPlatform = 0;
+	unsigned gpuDevice = 0;
+	std::vector<size_t> sizes = {1024, 16 * 1024, 256 * 1024};
+	std::vector<size_t> threads = {1, std::max(std::thread::hardware_concurrency(), 1u)};
+	std::chrono::milliseconds duration{500};
+	std::string farmDir = "bench-farm";
+	size_t farmFiles = 4;
+	Poco::UInt64 farmNonces = 8192;
+	bool farmGenerate = false;
+	size_t blocks = 3;
+	std::chrono::seconds roundTimeout{600};
+	std::string instructionSet = "AUTO";
+
+private:
+	void displayHelp(const std::string& name, const std::string& value);
+	void setMode(const std::string& name, const std::string& value);
+	void setFormat(const std::string& name, const std::string& value);
+	void setOutputPath(const std::string& name, const std::string& value);
+	void setGpu(const std::string& name, const std::string& value);
+	void setGpuPlatform(const std::string& name, const std::string& value);
+	void setGpuDevice(const std::string& name, const std::string& value);
+	void setSizes(const std::string& name, const std::string& value);
+	void setThreads(const std::string& name, const std::string& value);
+	void setDuration(const std::string& name, const std::string& value);
+	void setFarmDir(const std::string& name, const std::string& value);
+	void setFarmFiles(const std::string& name, const std::string& value);
+	void setFarmNonces(const std::string& name, const std::string& value);
+	void setFarmGenerate(const std::string& name, const std::string& value);
+	void setBlocks(const std::string& name, const std::string& value);
+	void setRoundTimeout(const std::string& name, const std::string& value);
+	void setInstructionSet(const std::string& name, const std::string& value);
+
+	static std::vector<size_t> parseList(const std::string& value);
+	static Poco::UInt64 parsePositive(const std::string& value);
+
+private:
+	Poco::Util::OptionSet options_;
+};
+
+struct BenchmarkRow
+{
+	std::string kind;
+	Burst::VerifierBenchmark::Result result;
+};
+
+/**
+ * \brief The account id of the plot files of the synthetic farm.
+ */
+const Poco::UInt64 FarmAccount = 1234567890123456789ull;
+
+bool runFarm(const Arguments& arguments, const std::string& processorType, std::vector<Burst::FarmBenchmark::Round>& rounds);
+
+void printCsv(const std::vector<BenchmarkRow>& rows, std::ostream& stream);
+void printJson(const std::vector<BenchmarkRow>& rows, std::ostream& stream);
+void printCsv(const std::vector<Burst::FarmBenchmark::Round>& rounds, std::ostream& stream);
+void printJson(const std::vector<Burst::FarmBenchmark::Round>& rounds, std::ostream& stream);
+
+int main(const int argc, const char* argv[])
+{
+	Arguments arguments;
+
+	if (!arguments.process(argc, argv))
+		return EXIT_FAILURE;
+
+	if (arguments.helpRequested)
+		return EXIT_SUCCESS;
+
+	Burst::MinerLogger::setup();
+
+	using Burst::VerifierBenchmark;
+
+	auto algorithms = VerifierBenchmark::getAvailableInstructionSets();
+	const auto instructionSets = algorithms;
+	std::vector<std::string> gpuAlgorithms = {"SIMULATED_GPU"};
+
+	if (arguments.gpu == "OPENCL" && Burst::Settings::OpenCl &&
+		Burst::MinerCL::getCL().create(arguments.gpuPlatform, arguments.gpuDevice))
+		gpuAlgorithms.emplace_back("OPENCL");
+	else if (arguments.gpu == "CUDA" && Burst::Settings::Cuda &&
+		Burst::Gpu_Cuda_Impl::useDevice(arguments.gpuDevice))
+		gpuAlgorithms.emplace_back("CUDA");
+	else if (!arguments.gpu.empty())
+		log_error(Burst::MinerLogger::general, "The GPU %s is not available, only the CPU is measured", arguments.gpu);
+
+	std::vector<BenchmarkRow> rows;
+	std::vector<Burst::FarmBenchmark::Round> rounds;
+
+	// an algorithm, that could not be measured, gets no row instead of misleading numbers
+	const auto addRow = [&rows](const std::string& kind, const std::string& algorithm, const VerifierBenchmark::Result& result)
+	{
+		if (result.isValid())
+			rows.push_back({kind, result});
+		else
+			log_error(Burst::MinerLogger::general, "The %s %s could not be measured", kind, algorithm);
+	};
+
+	// the farm is mined by the gpu, if there is one
+	if (arguments.mode == "farm" && !runFarm(arguments, gpuAlgorithms.size() > 1 ? gpuAlgorithms.back() : "CPU", rounds))
+		return EXIT_FAILURE;
+
+	if (arguments.mode == "all" || arguments.mode == "verifiers")
+	{
+		for (const auto& algorithm : algorithms)
+			for (const auto size : arguments.sizes)
+				for (const auto threads : arguments.threads)
+					addRow("verifier", algorithm, VerifierBenchmark::run(algorithm, size, threads, arguments.duration));
+
+		// a gpu is used by only one verifier in the miner
+		for (const auto& algorithm : gpuAlgorithms)
+			for (const auto size : arguments.sizes)
+				addRow("verifier", algorithm, VerifierBenchmark::run(algorithm, size, 1, arguments.duration));
+	}
+
+	if (arguments.mode == "all" || arguments.mode == "generators")
+		for (const auto& instructionSet : instructionSets)
+			for (const auto threads : arguments.threads)
+				addRow("generator", instructionSet, VerifierBenchmark::runGenerator(instructionSet, threads, arguments.duration));
+
+	const auto print = [&](std::ostream& stream)
+	{
+		if (arguments.mode == "farm" && arguments.format == "json")
+			printJson(rounds, stream);
+		else if (arguments.mode == "farm")
+			printCsv(rounds, stream);
+		else if (arguments.format == "json")
+			printJson(rows, stream);
+		else
+			printCsv(rows, stream);
+	};
+
+	if (arguments.outputPath.empty())
+		print(std::cout);
+	else
+	{
+		Poco::FileOutputStream stream{arguments.outputPath};
+		print(stream);
+	}
+
+	return EXIT_SUCCESS;
+}
+
+bool runFarm(const Arguments& arguments, const std::string& processorType, std::vector<Burst::FarmBenchmark::Round>& rounds)
+{
+	Poco::Data::SQLite::Connector::registerConnector();
+
+	Burst::SyntheticFarm farm{arguments.farmDir, FarmAccount, arguments.farmFiles, arguments.farmNonces};
+	const auto generatorThreads = *std::max_element(arguments.threads.begin(), arguments.threads.end());
+
+	if (!farm.create(arguments.farmGenerate, Burst::VerifierBenchmark::findFastestInstructionSet(), generatorThreads))
+		return false;
+
+	Burst::MockPool pool;
+
+	if (!pool.start())
+		return false;
+
+	const Burst::FarmBenchmark benchmark{farm, pool};
+
+	if (!benchmark.configure(processorType, arguments.instructionSet))
+	{
+		log_error(Burst::MinerLogger::general, "Could not load the config of the benchmark");
+		return false;
+	}
+
+	rounds = benchmark.run(arguments.blocks, arguments.roundTimeout);
+	pool.stop();
+	return true;
+}
+
+void printCsv(const std::vector<BenchmarkRow>& rows, std::ostream& stream)
+{
+	stream << "kind,algorithm,threads,bufferScoops,scoops,seconds,scoopsPerSecond,gigabytesPerSecond,nanosecondsPerScoop" << std::endl;
+
+	for (const auto& row : rows)
+		stream << row.kind << ','
+			<< row.result.instructionSet << ','
+			<< row.result.threads << ','
+			<< row.result.bufferSize << ','
+			<< row.result.scoops << ','
+			<< Poco::NumberFormatter::format(row.result.seconds, 3) << ','
+			<< Poco::NumberFormatter::format(row.result.getScoopsPerSecond(), 0) << ','
+			<< Poco::NumberFormatter::format(row.result.getBytesPerSecond() / 1e9, 3) << ','
+			<< Poco::NumberFormatter::format(row.result.getNanosecondsPerScoop(), 3) << std::endl;
+}
+
+void printJson(const std::vector<BenchmarkRow>& rows, std::ostream& stream)
+{
+	Poco::JSON::Array json;
+
+	for (const auto& row : rows)
+	{
+		Poco::JSON::Object entry;
+		entry.set("kind", row.kind);
+		entry.set("algorithm", row.result.instructionSet);
+		entry.set("threads", row.result.threads);
+		entry.set("bufferScoops", row.result.bufferSize);
+		entry.set("scoops", row.result.scoops);
+		entry.set("seconds", row.result.seconds);
+		entry.set("scoopsPerSecond", row.result.getScoopsPerSecond());
+		entry.set("gigabytesPerSecond", row.result.getBytesPerSecond() / 1e9);
+		entry.set("nanosecondsPerScoop", row.result.getNanosecondsPerScoop());
+		json.add(entry);
+	}
+
+	json.stringify(stream, 4);
+	stream << std::endl;
+}
+
+void printCsv(const std::vector<Burst::FarmBenchmark::Round>& rounds, std::ostream& stream)
+{
+	stream << "height,finished,seconds,scoops,scoopsPerSecond,gigabytesPerSecond,submissions" << std::endl;
+
+	for (const auto& round : rounds)
+		stream << round.height << ','
+			<< (round.finished ? "true" : "false") << ','
+			<< Poco::NumberFormatter::format(round.seconds, 3) << ','
+			<< round.scoops << ','
+			<< Poco::NumberFormatter::format(round.getScoopsPerSecond(), 0) << ','
+			<< Poco::NumberFormatter::format(round.getBytesPerSecond() / 1e9, 3) << ','
+			<< round.submissions << std::endl;
+}
+
+void printJson(const std::vector<Burst::FarmBenchmark::Round>& rounds, std::ostream& stream)
+{
+	Poco::JSON::Array json;
+
+	for (const auto& round : rounds)
+	{
+		Poco::JSON::Object entry;
+		entry.set("height", round.height);
+		entry.set("finished", round.finished);
+		entry.set("seconds", round.seconds);
+		entry.set("scoops", round.scoops);
+		entry.set("scoopsPerSecond", round.getScoopsPerSecond());
+		entry.set("gigabytesPerSecond", round.getBytesPerSecond() / 1e9);
+		entry.set("submissions", round.submissions);
+		json.add(entry);
+	}
+
+	json.stringify(stream, 4);
+	stream << std::endl;
+}
+
+Arguments::Arguments()
+{
+	using Poco::Util::Option;
+
+	options_.addOption(Option("help", "h", "Display this help information")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::displayHelp)));
+
+	options_.addOption(Option("mode", "m", "What is measured: all, verifiers, generators or farm (default: all)\n"
+		"farm mines a synthetic plot farm at a local mock pool and measures every round")
+		.required(false)
+		.repeatable(false)
+		.argument("mode")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setMode)));
+
+	options_.addOption(Option("format", "f", "The format of the results: csv or json (default: csv)")
+		.required(false)
+		.repeatable(false)
+		.argument("format")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setFormat)));
+
+	options_.addOption(Option("output", "o", "Writes the results into a file instead of the console")
+		.required(false)
+		.repeatable(false)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setOutputPath)));
+
+	options_.addOption(Option("sizes", "s", "The amount of scoops in a verified buffer, separated by commas\n"
+		"e.g. --sizes=1024,16384,262144")
+		.required(false)
+		.repeatable(false)
+		.argument("scoops")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setSizes)));
+
+	options_.addOption(Option("threads", "t", "The amount of threads, separated by commas (default: 1 and all cores)\n"
+		"e.g. --threads=1,2,4,8")
+		.required(false)
+		.repeatable(false)
+		.argument("threads")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setThreads)));
+
+	options_.addOption(Option("duration", "d", "The minimal duration of every measurement in milliseconds (default: 500)")
+		.required(false)
+		.repeatable(false)
+		.argument("ms")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setDuration)));
+
+	options_.addOption(Option("gpu", "g", "Also measures a GPU: CUDA or OPENCL (in the farm mode the GPU mines)")
+		.required(false)
+		.repeatable(false)
+		.argument("type")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setGpu)));
+
+	options_.addOption(Option("gpu-platform", "", "The OpenCL platform (default: 0)")
+		.required(false)
+		.repeatable(false)
+		.argument("index")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setGpuPlatform)));
+
+	options_.addOption(Option("gpu-device", "", "The GPU device (default: 0)")
+		.required(false)
+		.repeatable(false)
+		.argument("index")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setGpuDevice)));
+
+	options_.addOption(Option("farm-dir", "", "The directory of the synthetic farm (default: bench-farm)")
+		.required(false)
+		.repeatable(false)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setFarmDir)));
+
+	options_.addOption(Option("farm-files", "", "The amount of plot files of the synthetic farm (default: 4)")
+		.required(false)
+		.repeatable(false)
+		.argument("files")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setFarmFiles)));
+
+	options_.addOption(Option("farm-nonces", "", "The amount of nonces of every plot file (default: 8192)")
+		.required(false)
+		.repeatable(false)
+		.argument("nonces")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setFarmNonces)));
+
+	options_.addOption(Option("farm-generate", "", "Generates the nonces of the plot files instead of creating sparse files")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setFarmGenerate)));
+
+	options_.addOption(Option("blocks", "b", "The amount of mined blocks in the farm mode (default: 3)")
+		.required(false)
+		.repeatable(false)
+		.argument("blocks")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setBlocks)));
+
+	options_.addOption(Option("round-timeout", "", "The maximal time of a round in seconds (default: 600)")
+		.required(false)
+		.repeatable(false)
+		.argument("seconds")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setRoundTimeout)));
+
+	options_.addOption(Option("instruction-set", "i", "The CPU instruction set of the miner in the farm mode (default: AUTO)")
+		.required(false)
+		.repeatable(false)
+		.argument("set")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setInstructionSet)));
+}
+
+bool Arguments::process(const int argc, const char* argv[])
+{
+	Poco::Util::OptionProcessor optionProcessor(options_);
+	optionProcessor.setUnixStyle(std::string(Burst::Settings::OsFamily) != "Windows");
+
+	try
+	{
+		for (auto i = 1; i < argc; ++i)
+		{
+			std::string name;
+			std::string value;
+
+			if (optionProcessor.process(argv[i], name, value))
+			{
+				if (!name.empty())
+				{
+					const auto& option = options_.getOption(name);
+
+					if (option.validator())
+						option.validator()->validate(option, value);
+
+					if (option.callback())
+						option.callback()->invoke(name, value);
+				}
+			}
+		}
+
+		optionProcessor.checkRequired();
+		return true;
+	}
+	catch (...)
+	{
+		displayHelp("", "");
+		return false;
+	}
+}
+
+void Arguments::displayHelp(const std::string& name, const std::string& value)
+{
+	Poco::Util::HelpFormatter helpFormatter(options_);
+	helpFormatter.setUnixStyle(std::string(Burst::Settings::OsFamily) != "Windows");
+	helpFormatter.setCommand("creepMiner-bench");
+	helpFormatter.setUsage("<options>");
+	helpFormatter.setHeader("Measures the verification and plot generation kernels of creepMiner on synthetic data.");
+	helpFormatter.setFooter("Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)");
+	helpFormatter.setAutoIndent();
+	helpFormatter.format(std::cout);
+
+	helpRequested = true;
+}
+
+void Arguments::setMode(const std::string& name, const std::string& value)
+{
+	if (value != "all" && value != "verifiers" && value != "generators" && value != "farm")
+		throw Poco::InvalidArgumentException{"Unknown mode " + value};
+
+	mode = value;
+}
+
+void Arguments::setFormat(const std::string& name, const std::string& value)
+{
+	if (value != "csv" && value != "json")
+		throw Poco::InvalidArgumentException{"Unknown format " + value};
+
+	format = value;
+}
+
+void Arguments::setOutputPath(const std::string& name, const std::string& value)
+{
+	outputPath = value;
+}
+
+void Arguments::setGpu(const std::string& name, const std::string& value)
+{
+	gpu = Poco::toUpper(value);
+}
+
+void Arguments::setGpuPlatform(const std::string& name, const std::string& value)
+{
+	gpuPlatform = Poco::NumberParser::parseUnsigned(value);
+}
+
+void Arguments::setGpuDevice(const std::string& name, const std::string& value)
+{
+	gpuDevice = Poco::NumberParser::parseUnsigned(value);
+}
+
+void Arguments::setSizes(const std::string& name, const std::string& value)
+{
+	sizes = parseList(value);
+}
+
+void Arguments::setThreads(const std::string& name, const std::string& value)
+{
+	threads = parseList(value);
+}
+
+void Arguments::setDuration(const std::string& name, const std::string& value)
+{
+	duration = std::chrono::milliseconds{Poco::NumberParser::parseUnsigned64(value)};
+}
+
+void Arguments::setFarmDir(const std::string& name, const std::string& value)
+{
+	farmDir = value;
+}
+
+void Arguments::setFarmFiles(const std::string& name, const std::string& value)
+{
+	farmFiles = static_cast<size_t>(parsePositive(value));
+}
+
+void Arguments::setFarmNonces(const std::string& name, const std::string& value)
+{
+	farmNonces = parsePositive(value);
+}
+
+void Arguments::setFarmGenerate(const std::string& name, const std::string& value)
+{
+	farmGenerate = true;
+}
+
+void Arguments::setBlocks(const std::string& name, const std::string& value)
+{
+	blocks = static_cast<size_t>(parsePositive(value));
+}
+
+void Arguments::setRoundTimeout(const std::string& name, const std::string& value)
+{
+	roundTimeout = std::chrono::seconds{parsePositive(value)};
+}
+
+void Arguments::setInstructionSet(const std::string& name, const std::string& value)
+{
+	instructionSet = Poco::toUpper(value);
+}
+
+std::vector<size_t> Arguments::parseList(const std::string& value)
+{
+	std::vector<size_t> list;
+	Poco::StringTokenizer tokenizer{value, ",", Poco::StringTokenizer::TOK_TRIM | Poco::StringTokenizer::TOK_IGNORE_EMPTY};
+
+	for (const auto& token : tokenizer)
+		list.emplace_back(static_cast<size_t>(parsePositive(token)));
+
+	if (list.empty())
+		throw Poco::InvalidArgumentException{"The list " + value + " is empty"};
+
+	return list;
+}
+
+Poco::UInt64 Arguments::parsePositive(const std::string& value)
+{
+	const auto number = Poco::NumberParser::parseUnsigned64(value);
+
+	if (number == 0)
+		throw Poco::InvalidArgumentException{"The value " + value + " is zero"};
+
+	return number;
+}
@@ -24,65 +24,317 @@
 #include "Declarations.hpp"
 #include "gpu/gpu_shell.hpp"
 #include "logging/Message.hpp"
+#include "mining/ForkGensigs.hpp"
+#include <array>
+#include <algorithm>
 
 namespace Burst
 {
+	/**
+	 * \brief The device memory of a GPU verifier, that is kept between the chunks.
+	 * There is one pipeline per verifier thread (and so per stream). The buffers grow to the biggest
+	 * batch and every gensig is only uploaded, when it changes (once per block).
+	 * The gensig of the block and the gensigs of the fork tips have their own buffers on the device,
+	 * so alternating between them does not upload them again.
+	 * There are two slots, so the upload of the next batch is queued, while the current batch is verified.
+	 * \tparam TGpu_Impl The implementation of the GPU.
+	 */
+	template <typename TGpu_Impl>
+	class Gpu_Pipeline
+	{
+	public:
+		struct Slot
+		{
+			ScoopData* scoops = nullptr;
+			Poco::UInt64* deadlines = nullptr;
+		};
+
+		/**
+		 * \brief The maximal amount of gensigs, a batch is verified against (the block and its fork tips).
+		 */
+		static constexpr size_t MaxGensigs = ForkGensigs::MaxForks + 1;
+
+		Gpu_Pipeline() = default;
+		~Gpu_Pipeline();
+
+		Gpu_Pipeline(const Gpu_Pipeline&) = delete;
+		Gpu_Pipeline& operator=(const Gpu_Pipeline&) = delete;
+
+		/**
+		 * \brief Makes sure, that every slot can hold a batch.
+		 * \param nonces The amount of nonces in the batch.
+		 * \param gensigs The amount of gensigs, the batch is verified against.
+		 * \return true, if the memory is allocated.
+		 */
+		bool reserve(size_t nonces, size_t gensigs = 1);
+
+		/**
+		 * \brief Uploads a gensig, if it is not already on the device.
+		 * \param gensig The gensig of the current block or of a fork tip.
+		 * \param index The buffer of the gensig (0 for the block, 1... for the fork tips).
+		 * \param stream The stream of the verifier.
+		 * \return true, if the gensig is on the device.
+		 */
+		bool setGensig(const GensigData& gensig, size_t index, void* stream);
+
+		GensigData* getGensig(size_t index) const;
+		Slot& getSlot(size_t batch);
+
+		/**
+		 * \brief Returns the deadlines of a batch, that were calculated with one of the gensigs.
+		 */
+		Poco::UInt64* getDeadlines(size_t batch, size_t gensig);
+
+		/**
+		 * \brief Returns the pipeline of the calling verifier thread.
+		 */
+		static Gpu_Pipeline& get();
+
+	private:
+		void release();
+		void releaseSlots();
+
+		std::array<Slot, 2> slots_;
+		std::array<GensigData*, MaxGensigs> gpuGensigs_{};
+		std::array<GensigData, MaxGensigs> gensigs_{};
+		std::array<bool, MaxGensigs> hasGensigs_{};
+		size_t capacity_ = 0;
+		size_t gensigCapacity_ = 0;
+	};
+
 	struct Gpu_Algorithm_Atomic
 	{
+		/**
+		 * \brief Chunks with less nonces are verified in one batch.
+		 */
+		static constexpr size_t MinBatchSize = 16 * 1024;
+
+		/**
+		 * \brief The amount of batches, a big chunk is split into.
+		 */
+		static constexpr size_t BatchCount = 2;
+
 		template <typename TGpu_Impl>
-		static bool run(std::vector<ScoopData>& scoops,
+		static bool run(const ScoopData* scoops, size_t nonces,
 			const GensigData& gensig,
 			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, void* stream,
 			std::pair<Poco::UInt64, Poco::UInt64>& bestDeadline)
+		{
+			const GensigData* gensigs[] = {&gensig};
+			return runForks<TGpu_Impl>(scoops, nonces, gensigs, 1, nonceStart, baseTarget, stream, &bestDeadline);
+		}
+
+		/**
+		 * \brief Verifies the scoops against several gensigs (the block and its fork tips).
+		 * Every batch is uploaded only once and then verified against all gensigs.
+		 * \param gensigs The gensigs, only the first Gpu_Pipeline::MaxGensigs are verified.
+		 * \param count The amount of gensigs.
+		 * \param bestDeadlines Receives the best pair of every gensig.
+		 */
+		template <typename TGpu_Impl>
+		static bool runForks(const ScoopData* scoops, size_t nonces,
+			const GensigData* const* gensigs, size_t count,
+			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, void* stream,
+			std::pair<Poco::UInt64, Poco::UInt64>* bestDeadlines)
 		{
 			using shell = Gpu_Shell<TGpu_Impl>;
 
-			auto ok = true;
-			ScoopData* gpuScoops;
-			GensigData* gpuGensig;
-			Poco::UInt64* gpuDeadlines;
+			auto& pipeline = Gpu_Pipeline<TGpu_Impl>::get();
+			const auto batchSize = nonces < MinBatchSize * BatchCount ? nonces : (nonces + BatchCount - 1) / BatchCount;
 			std::string errorString;
-			const auto nonces = scoops.size();
 			Poco::UInt64 minDeadline;
 			Poco::UInt64 minDeadlineIndex;
 
-			// allocate the memory for the gpu
-			auto allocated = shell::allocateMemory(reinterpret_cast<void**>(&gpuScoops), MemoryType::Buffer, nonces);
-			allocated = allocated && shell::allocateMemory(reinterpret_cast<void**>(&gpuGensig), MemoryType::Gensig, 1);
-			allocated = allocated && shell::allocateMemory(reinterpret_cast<void**>(&gpuDeadlines), MemoryType::Bytes, nonces * sizeof(Poco::UInt64));
+			count = std::min(count, Gpu_Pipeline<TGpu_Impl>::MaxGensigs);
 
-			ok = allocated;
+			// the memory is only allocated, when the chunk is bigger than all chunks before
+			auto ok = pipeline.reserve(batchSize, count);
 
-			// copy the memory from RAM to gpu
-			ok = ok && shell::copyMemory(scoops.data(), gpuScoops, MemoryType::Buffer, nonces, MemoryCopyDirection::ToDevice, stream);
-			ok = ok && shell::copyMemory(&gensig, gpuGensig, MemoryType::Gensig, 1, MemoryCopyDirection::ToDevice, stream);
+			for (size_t g = 0; ok && g < count; ++g)
+				ok = pipeline.setGensig(*gensigs[g], g, stream);
 
-			// calculate the deadlines on gpu
-			ok = ok && shell::verify(gpuGensig, gpuScoops, gpuDeadlines, nonces, nonceStart, baseTarget, stream);
+			// collects the best deadlines of a verified batch
+			const auto collect = [&](const size_t batch)
+			{
+				const auto offset = batch * batchSize;
+				const auto size = std::min(batchSize, nonces - offset);
 
-			// get the best deadline on gpu
-			ok = ok && shell::getMinDeadline(gpuDeadlines, nonces, minDeadline, minDeadlineIndex, stream);
+				for (size_t g = 0; g < count; ++g)
+				{
+					if (!shell::getMinDeadline(pipeline.getDeadlines(batch, g), size, minDeadline, minDeadlineIndex, stream))
+						return false;
 
-			// fetch the last error if there is one
-			ok = !shell::getError(errorString);
+					if (batch == 0 || minDeadline < bestDeadlines[g].second)
+					{
+						bestDeadlines[g].first = nonceStart + offset + minDeadlineIndex;
+						bestDeadlines[g].second = minDeadline;
+					}
+				}
+
+				return true;
+			};
+
+			size_t batch = 0;
 
-			if (ok)
+			for (size_t offset = 0; ok && offset < nonces; offset += batchSize, ++batch)
 			{
-				bestDeadline.first = nonceStart + minDeadlineIndex;
-				bestDeadline.second = minDeadline;
+				const auto size = std::min(batchSize, nonces - offset);
+				auto& slot = pipeline.getSlot(batch);
+
+				// queue the upload and the verifications of this batch...
+				ok = shell::copyMemoryAsync(scoops + offset, slot.scoops, MemoryType::Buffer, size,
+					MemoryCopyDirection::ToDevice, stream);
+
+				for (size_t g = 0; ok && g < count; ++g)
+					ok = shell::verify(pipeline.getGensig(g), slot.scoops, pipeline.getDeadlines(batch, g), size,
+						nonceStart + offset, baseTarget, stream);
+
+				// ...before waiting for the result of the last one
+				if (ok && batch > 0)
+					ok = collect(batch - 1);
 			}
-			else
+
+			if (ok && batch > 0)
+				ok = collect(batch - 1);
+
+			// fetch the last error if there is one
+			ok = !shell::getError(errorString) && ok;
+
+			if (!ok)
 			{
+				std::fill(bestDeadlines, bestDeadlines + count, std::make_pair(Poco::UInt64{0}, Poco::UInt64{0}));
+
 				// print the error
 				log_error(MinerLogger::plotVerifier, "Error while verifying a plot file!\n\tError: %s", errorString);
 			}
 
-			// give the memory on gpu free
-			ok = ok && shell::freeMemory(gpuScoops);
-			ok = ok && shell::freeMemory(gpuGensig);
-			ok = ok && shell::freeMemory(gpuDeadlines);
-			
 			return ok;
 		}
 	};
+
+	template <typename TGpu_Impl>
+	constexpr size_t Gpu_Pipeline<TGpu_Impl>::MaxGensigs;
+
+	template <typename TGpu_Impl>
+	Gpu_Pipeline<TGpu_Impl>::~Gpu_Pipeline()
+	{
+		release();
+	}
+
+	template <typename TGpu_Impl>
+	bool Gpu_Pipeline<TGpu_Impl>::reserve(size_t nonces, size_t gensigs)
+	{
+		using shell = Gpu_Shell<TGpu_Impl>;
+
+		for (size_t i = 0; i < gensigs; ++i)
+			if (gpuGensigs_[i] == nullptr && !shell::allocateMemory(reinterpret_cast<void**>(&gpuGensigs_[i]), MemoryType::Gensig, 1))
+			{
+				gpuGensigs_[i] = nullptr;
+				return false;
+			}
+
+		if (nonces <= capacity_ && gensigs <= gensigCapacity_)
+			return true;
+
+		// the old content is not needed anymore, so the buffers are not resized but replaced
+		nonces = std::max(nonces, capacity_);
+		gensigs = std::max(gensigs, gensigCapacity_);
+		releaseSlots();
+
+		// every gensig has its own deadlines, so all of them can be verified before the first result is fetched
+		for (auto& slot : slots_)
+		{
+			if (!shell::allocateMemory(reinterpret_cast<void**>(&slot.scoops), MemoryType::Buffer, nonces))
+				slot.scoops = nullptr;
+
+			if (!shell::allocateMemory(reinterpret_cast<void**>(&slot.deadlines), MemoryType::Bytes,
+				nonces * gensigs * sizeof(Poco::UInt64)))
+				slot.deadlines = nullptr;
+
+			if (slot.scoops == nullptr || slot.deadlines == nullptr)
+			{
+				releaseSlots();
+				return false;
+			}
+		}
+
+		capacity_ = nonces;
+		gensigCapacity_ = gensigs;
+		return true;
+	}
+
+	template <typename TGpu_Impl>
+	bool Gpu_Pipeline<TGpu_Impl>::setGensig(const GensigData& gensig, const size_t index, void* stream)
+	{
+		using shell = Gpu_Shell<TGpu_Impl>;
+
+		if (hasGensigs_[index] && gensigs_[index] == gensig)
+			return true;
+
+		hasGensigs_[index] = shell::copyMemory(&gensig, gpuGensigs_[index], MemoryType::Gensig, 1,
+			MemoryCopyDirection::ToDevice, stream);
+		gensigs_[index] = gensig;
+
+		return hasGensigs_[index];
+	}
+
+	template <typename TGpu_Impl>
+	GensigData* Gpu_Pipeline<TGpu_Impl>::getGensig(const size_t index) const
+	{
+		return gpuGensigs_[index];
+	}
+
+	template <typename TGpu_Impl>
+	typename Gpu_Pipeline<TGpu_Impl>::Slot& Gpu_Pipeline<TGpu_Impl>::getSlot(const size_t batch)
+	{
+		return slots_[batch % slots_.size()];
+	}
+
+	template <typename TGpu_Impl>
+	Poco::UInt64* Gpu_Pipeline<TGpu_Impl>::getDeadlines(const size_t batch, const size_t gensig)
+	{
+		return getSlot(batch).deadlines + gensig * capacity_;
+	}
+
+	template <typename TGpu_Impl>
+	Gpu_Pipeline<TGpu_Impl>& Gpu_Pipeline<TGpu_Impl>::get()
+	{
+		thread_local Gpu_Pipeline pipeline;
+		return pipeline;
+	}
+
+	template <typename TGpu_Impl>
+	void Gpu_Pipeline<TGpu_Impl>::release()
+	{
+		using shell = Gpu_Shell<TGpu_Impl>;
+
+		releaseSlots();
+
+		for (auto& gpuGensig : gpuGensigs_)
+			if (gpuGensig != nullptr)
+				shell::freeMemory(gpuGensig);
+
+		gpuGensigs_.fill(nullptr);
+		hasGensigs_.fill(false);
+	}
+
+	template <typename TGpu_Impl>
+	void Gpu_Pipeline<TGpu_Impl>::releaseSlots()
+	{
+		using shell = Gpu_Shell<TGpu_Impl>;
+
+		for (auto& slot : slots_)
+		{
+			if (slot.scoops != nullptr)
+				shell::freeMemory(slot.scoops);
+
+			if (slot.deadlines != nullptr)
+				shell::freeMemory(slot.deadlines);
+
+			slot = Slot{};
+		}
+
+		capacity_ = 0;
+		gensigCapacity_ = 0;
+	}
 }
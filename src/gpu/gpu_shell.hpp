@@ -23,6 +23,7 @@
 
 #include "impl/gpu_cuda_impl.hpp"
 #include "impl/gpu_opencl_impl.hpp"
+#include "impl/gpu_simulated_impl.hpp"
 
 namespace Burst
 {
@@ -75,6 +76,19 @@ namespace Burst
 			return TImpl::copyMemory(std::forward<Args&&>(args)...);
 		}
 
+		/**
+		 * \brief Queues a copy of a memory block without waiting for it.
+		 * The source needs to stay valid, until the stream is synchronized (by a blocking call).
+		 * \tparam Args Variadic template types.
+		 * \param args The arguments to copy the memory.
+		 * \return true, when the copy was queued, false otherwise.
+		 */
+		template <typename ...Args>
+		static bool copyMemoryAsync(Args&&... args)
+		{
+			return TImpl::copyMemoryAsync(std::forward<Args&&>(args)...);
+		}
+
 		/**
 		 * \brief Frees a memory block on the GPU.
 		 * \tparam Args Variadic template types.
@@ -141,6 +155,19 @@ namespace Burst
 			return TAlgorithm::template run<Gpu_Shell>(std::forward<Args&&>(args)...);
 		}
 
+		/**
+		 * \brief Runs an algorithm to search for the best deadlines of several gensigs in a memory block.
+		 * \tparam TAlgorithm The type of the algorithm that is used.
+		 * \tparam Args Variadic template types.
+		 * \param args The arguments that are needed for the search of deadlines.
+		 * \return true, when there was no error, false otherwise.
+		 */
+		template <typename TAlgorithm, typename ...Args>
+		static bool runForks(Args&&... args)
+		{
+			return TAlgorithm::template runForks<Gpu_Shell>(std::forward<Args&&>(args)...);
+		}
+
 		/**
 		 * \brief Gets the last error, if any occured.
 		 * \tparam Args Variadic template types.
@@ -189,4 +216,5 @@ namespace Burst
 
 	using GpuCuda = Gpu_Shell<Gpu_Cuda_Impl>;
 	using GpuOpenCL = Gpu_Shell<Gpu_Opencl_Impl>;
+	using GpuSimulated = Gpu_Shell<Gpu_Simulated_Impl>;
 }
@@ -102,6 +102,12 @@ bool Burst::Gpu_Cuda_Impl::copyMemory(const void* input, void* output, MemoryTyp
 	return true;
 }
 
+bool Burst::Gpu_Cuda_Impl::copyMemoryAsync(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction, void* stream)
+{
+	// there are no cuda streams (yet), so the copy is synchronous
+	return copyMemory(input, output, type, size, direction, stream);
+}
+
 #ifndef USE_CUDA
 void cuda_calc_occupancy(int bufferSize, int& gridSize, int& blockSize)
 {
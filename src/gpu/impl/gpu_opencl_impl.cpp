@@ -305,13 +305,24 @@ bool Burst::Gpu_Opencl_Impl::getError(std::string& errorString)
 }
 
 bool Burst::Gpu_Opencl_Impl::copyMemory(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction, void* stream)
+{
+	return enqueueCopy(input, output, type, size, direction, stream, true);
+}
+
+bool Burst::Gpu_Opencl_Impl::copyMemoryAsync(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction, void* stream)
+{
+	return enqueueCopy(input, output, type, size, direction, stream, false);
+}
+
+bool Burst::Gpu_Opencl_Impl::enqueueCopy(const void* input, void* output, MemoryType type, size_t size,
+	MemoryCopyDirection direction, void* stream, bool blocking)
 {
 #ifdef USE_OPENCL
 	size = Gpu_Helper::calcMemorySize(type, size);
 
 	if (direction == MemoryCopyDirection::ToDevice)
 	{
-		const auto ret = clEnqueueWriteBuffer(static_cast<cl_command_queue>(stream), cl_mem(output), CL_TRUE, 0, size, input, 0,
+		const auto ret = clEnqueueWriteBuffer(static_cast<cl_command_queue>(stream), cl_mem(output), blocking ? CL_TRUE : CL_FALSE, 0, size, input, 0,
 		                                      nullptr, nullptr);
 
 		if (ret == CL_SUCCESS)
@@ -323,7 +334,7 @@ bool Burst::Gpu_Opencl_Impl::copyMemory(const void* input, void* output, MemoryT
 
 	if (direction == MemoryCopyDirection::ToHost)
 	{
-		const auto ret = clEnqueueReadBuffer(static_cast<cl_command_queue>(stream), cl_mem(input), CL_TRUE, 0, size, output, 0,
+		const auto ret = clEnqueueReadBuffer(static_cast<cl_command_queue>(stream), cl_mem(input), blocking ? CL_TRUE : CL_FALSE, 0, size, output, 0,
 		                                     nullptr, nullptr);
 
 		if (ret == CL_SUCCESS)
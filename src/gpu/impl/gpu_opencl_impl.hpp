@@ -35,6 +35,7 @@ namespace Burst
 		static bool initStream(void** stream);
 		static bool allocateMemory(void** memory, MemoryType type, size_t size);
 		static bool copyMemory(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction, void* stream);
+		static bool copyMemoryAsync(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction, void* stream);
 		static bool verify(const GensigData* gpuGensig, ScoopData* gpuScoops, Poco::UInt64* gpuDeadlines, size_t nonces,
 			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, void* stream);
 		static bool getMinDeadline(Poco::UInt64* gpuDeadlines, size_t size, Poco::UInt64& minDeadline, Poco::UInt64& minDeadlineIndex, void* stream);
@@ -42,6 +43,9 @@ namespace Burst
 		static bool getError(std::string& errorString);
 
 	private:
+		static bool enqueueCopy(const void* input, void* output, MemoryType type, size_t size, MemoryCopyDirection direction,
+			void* stream, bool blocking);
+
 		static int lastError_;
 	};
 }
@@ -0,0 +1,112 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "gpu_simulated_impl.hpp"
+#include "logging/MinerLogger.hpp"
+#include "shabal/MinerShabal.hpp"
+#include "Declarations.hpp"
+#include "gpu/gpu_shell.hpp"
+#include <algorithm>
+#include <cstring>
+
+bool Burst::Gpu_Simulated_Impl::initStream(void** stream)
+{
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::allocateMemory(void** memory, MemoryType type, size_t size)
+{
+	size = Gpu_Helper::calcMemorySize(type, size);
+	*memory = new char[size];
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::copyMemory(const void* input, void* output, MemoryType type, size_t size,
+	MemoryCopyDirection direction, void* stream)
+{
+	size = Gpu_Helper::calcMemorySize(type, size);
+	memcpy(output, input, size);
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::copyMemoryAsync(const void* input, void* output, MemoryType type, size_t size,
+	MemoryCopyDirection direction, void* stream)
+{
+	return copyMemory(input, output, type, size, direction, stream);
+}
+
+bool Burst::Gpu_Simulated_Impl::verify(const GensigData* gpuGensig, ScoopData* gpuScoops, Poco::UInt64* gpuDeadlines,
+	size_t nonces, Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, void* stream)
+{
+	// the same kernel as on the real devices: one deadline per nonce
+	const ShabalMidstates midstates{*gpuGensig};
+	const auto& midstate = midstates.get<Shabal256_SSE2>();
+	HashData target;
+
+	for (size_t i = 0; i < nonces; ++i)
+	{
+		auto shabal = midstate;
+		shabal.update(gpuScoops + i, Settings::ScoopSize);
+		shabal.close(target.data());
+
+		Poco::UInt64 result;
+		memcpy(&result, target.data(), sizeof(Poco::UInt64));
+		gpuDeadlines[i] = result / baseTarget;
+	}
+
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::getMinDeadline(Poco::UInt64* gpuDeadlines, size_t size, Poco::UInt64& minDeadline,
+	Poco::UInt64& minDeadlineIndex, void* stream)
+{
+	const auto minElement = std::min_element(gpuDeadlines, gpuDeadlines + size);
+
+	if (minElement == gpuDeadlines + size)
+		return false;
+
+	minDeadline = *minElement;
+	minDeadlineIndex = static_cast<Poco::UInt64>(minElement - gpuDeadlines);
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::freeMemory(void* memory)
+{
+	delete[] static_cast<char*>(memory);
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::getError(std::string& errorString)
+{
+	return false;
+}
+
+bool Burst::Gpu_Simulated_Impl::listDevices()
+{
+	log_system(MinerLogger::general, "Simulated GPU devices:");
+	log_system(MinerLogger::general, "\tDevice[0]: Host");
+	return true;
+}
+
+bool Burst::Gpu_Simulated_Impl::useDevice(unsigned device)
+{
+	return true;
+}
@@ -46,7 +46,12 @@
 #include <Poco/DirectoryIterator.h>
 #include <regex>
 #include <Poco/Data/SQLite/Connector.h>
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
 #include "MinerUtil.hpp"
+#include "plots/PlotWriter.hpp"
+#include "plots/PlotConverter.hpp"
+#include "plots/Plot.hpp"
 
 class SslInitializer
 {
@@ -70,10 +75,30 @@ struct Arguments
 
 	bool helpRequested = false;
 	std::string confPath = "mining.conf";
+	std::string plotDir;
+	Poco::UInt64 plotAccount = 0;
+	Poco::UInt64 plotStartNonce = 0;
+	Poco::UInt64 plotNonces = 0;
+	size_t plotThreads = 0;
+	Poco::UInt64 plotMemory = 1024;
+	std::string plotInstructionSet = "AUTO";
+	bool plotBuffered = false;
+	std::string convertPath;
 
 private:
 	void displayHelp(const std::string& name, const std::string& value);
 	void setConfPath(const std::string& name, const std::string& value);
+	void setPlotDir(const std::string& name, const std::string& value);
+	void setPlotAccount(const std::string& name, const std::string& value);
+	void setPlotStartNonce(const std::string& name, const std::string& value);
+	void setPlotNonces(const std::string& name, const std::string& value);
+	void setPlotThreads(const std::string& name, const std::string& value);
+	void setPlotMemory(const std::string& name, const std::string& value);
+	void setPlotInstructionSet(const std::string& name, const std::string& value);
+	void setPlotBuffered(const std::string& name, const std::string& value);
+	void setConvertPath(const std::string& name, const std::string& value);
+
+	static Poco::UInt64 parsePositive(const std::string& value);
 
 private:
 	Poco::Util::OptionSet options_;
@@ -93,6 +118,39 @@ int main(const int argc, const char* argv[])
 
 	Burst::MinerLogger::setup();
 
+	// plotter mode, write the plot file and exit
+	if (!arguments.plotDir.empty())
+	{
+		Burst::PlotWriter writer{arguments.plotDir, arguments.plotAccount, arguments.plotStartNonce, arguments.plotNonces};
+		writer.setThreads(arguments.plotThreads);
+		writer.setMaxMemory(arguments.plotMemory * 1024 * 1024);
+		writer.setInstructionSet(arguments.plotInstructionSet);
+		writer.setDirect(!arguments.plotBuffered);
+		return writer.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	// converter mode, convert the plot file in place and exit
+	if (!arguments.convertPath.empty())
+	{
+		if (Burst::isValidPlotFile(arguments.convertPath) != Burst::PlotCheckResult::Ok)
+		{
+			log_error(Burst::MinerLogger::general, "%s is not a valid plot file", arguments.convertPath);
+			return EXIT_FAILURE;
+		}
+
+		Burst::PlotFile plotFile{std::string(arguments.convertPath), Poco::File{arguments.convertPath}.getSize()};
+
+		if (!plotFile.isPoC(1))
+		{
+			log_error(Burst::MinerLogger::general, "%s is not a PoC1 plot file", arguments.convertPath);
+			return EXIT_FAILURE;
+		}
+
+		Burst::PlotConverter converter;
+		converter.setMaxMemory(arguments.plotMemory * 1024 * 1024);
+		return converter.convert(plotFile, []() { return false; }) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	// create a message dispatcher..
 	//auto messageDispatcher = Burst::Message::Dispatcher::create();
 	// ..and start it in its own thread
@@ -119,6 +177,7 @@ int main(const int argc, const char* argv[])
 	checkAndPrint(Sse4, "SSE4");
 	checkAndPrint(Avx, "AVX");
 	checkAndPrint(Avx2, "AVX2");
+	checkAndPrint(Avx512, "AVX512F");
 
 	log_information(general, Burst::Settings::Project.nameAndVersionVerbose);
 	log_information(general, "%s mode%s", mode, sstream.str());
@@ -303,6 +362,62 @@ Arguments::Arguments()
 		.repeatable(false)
 		.argument("path")
 		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setConfPath)));
+
+	options_.addOption(Option("plot", "", "Writes an optimized (PoC2) plot file into the directory instead of mining.\n"
+		"An interrupted plot file is continued, when the same options are used again")
+		.required(false)
+		.repeatable(false)
+		.argument("dir")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotDir)));
+
+	options_.addOption(Option("plot-account", "", "The numeric account id of the plot file")
+		.required(false)
+		.repeatable(false)
+		.argument("id")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotAccount)));
+
+	options_.addOption(Option("plot-start", "", "The first nonce of the plot file (default: 0)")
+		.required(false)
+		.repeatable(false)
+		.argument("nonce")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotStartNonce)));
+
+	options_.addOption(Option("plot-nonces", "", "The amount of nonces of the plot file (one nonce is 256 KiB)")
+		.required(false)
+		.repeatable(false)
+		.argument("nonces")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotNonces)));
+
+	options_.addOption(Option("plot-threads", "", "The amount of generator threads (default: all cores)")
+		.required(false)
+		.repeatable(false)
+		.argument("threads")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotThreads)));
+
+	options_.addOption(Option("plot-memory", "", "The memory of the staging buffers of the plotter\n"
+		"and of the swapped blocks of the converter in MiB (default: 1024)")
+		.required(false)
+		.repeatable(false)
+		.argument("MiB")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotMemory)));
+
+	options_.addOption(Option("plot-instruction-set", "", "The CPU instruction set of the generators (default: AUTO)")
+		.required(false)
+		.repeatable(false)
+		.argument("set")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotInstructionSet)));
+
+	options_.addOption(Option("plot-buffered", "", "Writes the plot file through the operating system cache instead of direct I/O")
+		.required(false)
+		.repeatable(false)
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setPlotBuffered)));
+
+	options_.addOption(Option("convert", "", "Converts a PoC1 plot file in place into a PoC2 plot file instead of mining.\n"
+		"An interrupted conversion is continued, when the plot file is converted again")
+		.required(false)
+		.repeatable(false)
+		.argument("path")
+		.callback(Poco::Util::OptionCallback<Arguments>(this, &Arguments::setConvertPath)));
 }
 
 bool Arguments::process(const int argc, const char* argv[])
@@ -333,6 +448,10 @@ bool Arguments::process(const int argc, const char* argv[])
 		}
 
 		optionProcessor.checkRequired();
+
+		if (!plotDir.empty() && (plotAccount == 0 || plotNonces == 0))
+			throw Poco::InvalidArgumentException{"The plotter needs an account and an amount of nonces"};
+
 		return true;
 	}
 	catch (...)
@@ -361,6 +480,61 @@ void Arguments::setConfPath(const std::string& name, const std::string& value)
 	confPath = value;
 }
 
+void Arguments::setPlotDir(const std::string& name, const std::string& value)
+{
+	plotDir = value;
+}
+
+void Arguments::setPlotAccount(const std::string& name, const std::string& value)
+{
+	plotAccount = parsePositive(value);
+}
+
+void Arguments::setPlotStartNonce(const std::string& name, const std::string& value)
+{
+	plotStartNonce = Poco::NumberParser::parseUnsigned64(value);
+}
+
+void Arguments::setPlotNonces(const std::string& name, const std::string& value)
+{
+	plotNonces = parsePositive(value);
+}
+
+void Arguments::setPlotThreads(const std::string& name, const std::string& value)
+{
+	plotThreads = static_cast<size_t>(parsePositive(value));
+}
+
+void Arguments::setPlotMemory(const std::string& name, const std::string& value)
+{
+	plotMemory = parsePositive(value);
+}
+
+void Arguments::setPlotInstructionSet(const std::string& name, const std::string& value)
+{
+	plotInstructionSet = Poco::toUpper(value);
+}
+
+void Arguments::setPlotBuffered(const std::string& name, const std::string& value)
+{
+	plotBuffered = true;
+}
+
+void Arguments::setConvertPath(const std::string& name, const std::string& value)
+{
+	convertPath = value;
+}
+
+Poco::UInt64 Arguments::parsePositive(const std::string& value)
+{
+	const auto number = Poco::NumberParser::parseUnsigned64(value);
+
+	if (number == 0)
+		throw Poco::InvalidArgumentException{"The value " + value + " is zero"};
+
+	return number;
+}
+
 KeyConfigHandler::KeyConfigHandler(bool server)
 	: PrivateKeyPassphraseHandler{server}
 {}
@@ -0,0 +1,97 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "ForkGensigs.hpp"
+#include "shabal/MinerShabal.hpp"
+#include <algorithm>
+
+constexpr size_t Burst::ForkGensigs::MaxForks;
+
+Burst::ForkGensigs::ForkGensigs()
+	: forks_{std::make_shared<Forks>()}
+{}
+
+bool Burst::ForkGensigs::isKnown(const std::string& gensigStr) const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	return std::find(known_.begin(), known_.end(), gensigStr) != known_.end();
+}
+
+bool Burst::ForkGensigs::add(const std::string& gensigStr, const GensigData& gensig, const bool sameScoop,
+	const size_t maxForks)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	if (std::find(known_.begin(), known_.end(), gensigStr) != known_.end())
+		return false;
+
+	known_.emplace_back(gensigStr);
+
+	if (!sameScoop || forks_->size() >= std::min(maxForks, MaxForks))
+		return false;
+
+	// the verifiers keep their old list, until they take the next chunk
+	auto forks = std::make_shared<Forks>(*forks_);
+
+	Fork fork;
+	fork.gensig = gensig;
+	fork.gensigStr = gensigStr;
+	fork.shabalMidstates = std::make_shared<ShabalMidstates>(gensig);
+
+	forks->emplace_back(std::move(fork));
+	results_.emplace_back();
+	forks_ = forks;
+
+	return true;
+}
+
+std::shared_ptr<const Burst::ForkGensigs::Forks> Burst::ForkGensigs::getForks() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	return forks_;
+}
+
+void Burst::ForkGensigs::addResult(const size_t fork, const Poco::UInt64 nonce, const Poco::UInt64 deadline,
+	const Poco::UInt64 accountId, const std::string& plotFile)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	if (fork >= results_.size())
+		return;
+
+	auto& result = results_[fork];
+
+	if (result.deadline != 0 && result.deadline <= deadline)
+		return;
+
+	result.nonce = nonce;
+	result.deadline = deadline;
+	result.accountId = accountId;
+	result.plotFile = plotFile;
+}
+
+void Burst::ForkGensigs::forResults(const std::function<void(const Fork&, const Result&)>& function) const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	for (size_t i = 0; i < forks_->size(); ++i)
+		function((*forks_)[i], results_[i]);
+}
@@ -0,0 +1,106 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "Declarations.hpp"
+#include <Poco/Types.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace Burst
+{
+	class ShabalMidstates;
+
+	/**
+	 * \brief The gensigs of competing fork tips at the height of the current block.
+	 * A fork tip, that selects the same scoop as the block, is verified with the same reads,
+	 * so the best deadlines for it are ready without reading the plot files again.
+	 */
+	class ForkGensigs
+	{
+	public:
+		/**
+		 * \brief The maximal amount of fork tips, that are verified next to the gensig of the block.
+		 */
+		static constexpr size_t MaxForks = 7;
+
+		struct Fork
+		{
+			GensigData gensig;
+			std::string gensigStr;
+			std::shared_ptr<const ShabalMidstates> shabalMidstates;
+		};
+
+		struct Result
+		{
+			Poco::UInt64 nonce = 0;
+			Poco::UInt64 deadline = 0;
+			Poco::UInt64 accountId = 0;
+			std::string plotFile;
+		};
+
+		using Forks = std::vector<Fork>;
+
+		ForkGensigs();
+
+		/**
+		 * \brief Returns true, if the gensig was already added (or rejected).
+		 */
+		bool isKnown(const std::string& gensigStr) const;
+
+		/**
+		 * \brief Adds the gensig of a fork tip.
+		 * \param gensigStr The gensig as a hex string.
+		 * \param gensig The gensig.
+		 * \param sameScoop True, if the fork tip selects the same scoop as the block, otherwise it is only remembered.
+		 * \param maxForks The maximal amount of fork tips.
+		 * \return true, if the fork tip is verified from now on.
+		 */
+		bool add(const std::string& gensigStr, const GensigData& gensig, bool sameScoop, size_t maxForks);
+
+		/**
+		 * \brief Returns the fork tips, that are verified.
+		 * The list is never changed, a new fork tip creates a new list.
+		 */
+		std::shared_ptr<const Forks> getForks() const;
+
+		/**
+		 * \brief Adds a deadline for a fork tip, it is only kept, if it is the best one.
+		 * \param fork The index of the fork tip inside getForks().
+		 */
+		void addResult(size_t fork, Poco::UInt64 nonce, Poco::UInt64 deadline, Poco::UInt64 accountId, const std::string& plotFile);
+
+		/**
+		 * \brief Calls a function for every fork tip and its best deadline.
+		 */
+		void forResults(const std::function<void(const Fork&, const Result&)>& function) const;
+
+	private:
+		std::shared_ptr<const Forks> forks_;
+		std::vector<Result> results_;
+		std::vector<std::string> known_;
+		mutable std::mutex mutex_;
+	};
+}
@@ -35,30 +35,64 @@
 #include <Poco/File.h>
 #include <Poco/Delegate.h>
 #include "plots/PlotVerifier.hpp"
+#include "plots/PlotCache.hpp"
+#include "plots/PlotConverter.hpp"
 #include "MinerCL.hpp"
+#include "ForkGensigs.hpp"
+#include <algorithm>
 
 namespace Burst
 {
 	namespace MinerHelper
 	{
+		SubmitFunction create_submit_function(Miner& miner)
+		{
+			return [&miner](Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
+			                Poco::UInt64 blockheight, const std::string& plotFile,
+			                bool ownAccount)
+			{
+				miner.submitNonceAsync(make_tuple(nonce, accountId, deadline, blockheight, plotFile, ownAccount));
+			};
+		}
+
+		template <typename T>
+		FusedVerifier::VerifyFunction create_fused_verifier(Miner& miner, std::shared_ptr<PlotReadProgress> progress,
+			const size_t subChunkSize)
+		{
+			const auto submitFunction = create_submit_function(miner);
+
+			return [submitFunction, progress, subChunkSize](VerifyNotification& notification, const std::function<bool()>& stop)
+			{
+				const auto bestResult = T::searchDeadline(notification, 0, notification.bufferSize, stop, nullptr, subChunkSize);
+				T::finish(notification, bestResult, submitFunction, progress.get());
+			};
+		}
+
 		template <typename T>
 		void create_worker_default(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
-			const size_t size, Miner& miner, Poco::NotificationQueue& queue, std::shared_ptr<PlotReadProgress> progress)
+			const size_t size, Miner& miner, VerificationQueue& queue, std::shared_ptr<PlotReadProgress> progress)
 		{
 			thread_pool = std::make_unique<Poco::ThreadPool>(1, static_cast<int>(size));
 			task_manager = std::make_unique<Poco::TaskManager>(*thread_pool);
 
-			auto submitFunction = [&miner](Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
-			                               Poco::UInt64 blockheight, const std::string& plotFile,
-			                               bool ownAccount)
-			{
-				miner.submitNonceAsync(make_tuple(nonce, accountId, deadline, blockheight, plotFile, ownAccount));
-			};
+			const auto submitFunction = create_submit_function(miner);
 
 			for (size_t i = 0; i < size; ++i)
 				task_manager->start(new T(miner.getData(), queue, progress, submitFunction));
 		}
 
+		template <typename T>
+		void add_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager, const size_t size, Miner& miner,
+			VerificationQueue& queue, std::shared_ptr<PlotReadProgress> progress)
+		{
+			thread_pool.addCapacity(static_cast<int>(size));
+
+			const auto submitFunction = create_submit_function(miner);
+
+			for (size_t i = 0; i < size; ++i)
+				task_manager.start(new T(miner.getData(), queue, progress, submitFunction));
+		}
+
 		template <typename T, typename ...Args>
 		void create_worker(std::unique_ptr<Poco::ThreadPool>& thread_pool, std::unique_ptr<Poco::TaskManager>& task_manager,
 			const size_t size, Args&&... args)
@@ -111,11 +145,22 @@ void Burst::Miner::run()
 
 		// create the plot readers
 		MinerHelper::create_worker<PlotReader>(plot_reader_pool_, plot_reader_, MinerConfig::getConfig().getMaxPlotReaders(),
-			data_, progressRead_, verificationQueue_, plotReadQueue_);
+			data_, progressRead_, progressVerify_, verificationQueue_, fusedVerifier_, plotReadScheduler_);
 
 		// create the plot verifiers
 		createPlotVerifiers();
 
+		// the plot cache is built between the rounds
+		if (!config.getPlotCacheDir().empty())
+		{
+			PlotCache::instance().setDir(config.getPlotCacheDir(), config.getPlotCacheMaxSize());
+			plotCacheBuilder_ = std::make_unique<Poco::TaskManager>();
+		}
+
+		// the PoC1 plot files are converted between the rounds too
+		if (config.isPoC2Conversion())
+			plotConverter_ = std::make_unique<Poco::TaskManager>();
+
 #ifndef USE_CUDA
 		if (config.getProcessorType() == "CUDA")
 			log_error(MinerLogger::miner, "You are mining with your CUDA GPU, but the miner is compiled without the CUDA SDK!\n"
@@ -186,9 +231,19 @@ void Burst::Miner::stop()
 {
 	poco_ndc(Miner::stop);
 
+	// stop the plot cache builder and the plot converter, they resume at the next start
+	for (const auto& manager : {plotCacheBuilder_.get(), plotConverter_.get()})
+	{
+		if (manager != nullptr)
+		{
+			manager->cancelAll();
+			manager->joinAll();
+		}
+	}
+
 	// stop plot reader
 	if (plot_reader_ != nullptr)
-		shut_down_worker(*plot_reader_pool_, *plot_reader_, plotReadQueue_);
+		shut_down_worker(*plot_reader_pool_, *plot_reader_, plotReadScheduler_);
 
 	// stop verifier
 	if (verifier_ != nullptr)
@@ -209,10 +264,15 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 	{
 		auto notification = new PlotReadNotification;
 		notification->dir = plotDir.getPath();
+		notification->device = plotDir.getDevice();
 		notification->gensig = getGensig();
+		notification->shabalMidstates = data_.getBlockData()->getShabalMidstates();
+		notification->forkGensigs = data_.getBlockData()->getForkGensigs();
 		notification->scoopNum = getScoopNum();
 		notification->blockheight = getBlockheight();
 		notification->baseTarget = getBaseTarget();
+		notification->targetDeadline = MinerConfig::getConfig().isDroppingDeadlinesAboveTarget() ?
+			MinerConfig::getConfig().getTargetDeadline() : 0;
 		notification->type = plotDir.getType();
 		notification->wakeUpCall = wakeUpCall;
 
@@ -222,14 +282,16 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 		return notification;
 	};
 
-	const auto addParallel = [this, &initPlotReadNotification](PlotDir& plotDir, std::shared_ptr<PlotFile> plotFile)
+	std::vector<PlotReadNotification::Ptr> notifications;
+
+	const auto addParallel = [&notifications, &initPlotReadNotification](PlotDir& plotDir, std::shared_ptr<PlotFile> plotFile)
 	{
 		auto plotRead = initPlotReadNotification(plotDir);
 		plotRead->plotList.emplace_back(plotFile);
-		plotReadQueue_.enqueueNotification(plotRead);
+		notifications.emplace_back(plotRead);
 	};
 
-	MinerConfig::getConfig().forPlotDirs([this, &addParallel, &initPlotReadNotification](PlotDir& plotDir)
+	MinerConfig::getConfig().forPlotDirs([&notifications, &addParallel, &initPlotReadNotification](PlotDir& plotDir)
 	{
 		if (plotDir.getType() == PlotDir::Type::Parallel)
 		{
@@ -248,11 +310,65 @@ void Burst::Miner::addPlotReadNotifications(bool wakeUpCall)
 			for (const auto& relatedPlotDir : plotDir.getRelatedDirs())
 				plotRead->relatedPlotLists.emplace_back(relatedPlotDir->getPath(), relatedPlotDir->getPlotfiles());
 
-			plotReadQueue_.enqueueNotification(plotRead);
+			notifications.emplace_back(plotRead);
 		}
 
 		return true;
 	});
+
+	if (MinerConfig::getConfig().getReadOrder() == "longestFirst")
+		orderPlotReadNotifications(notifications);
+
+	for (auto& notification : notifications)
+		plotReadScheduler_.enqueue(notification);
+}
+
+void Burst::Miner::orderPlotReadNotifications(std::vector<PlotReadNotification::Ptr>& notifications) const
+{
+	// the estimated read time is the amount of scoop bytes divided by the measured throughput of the directory
+	std::vector<std::pair<double, PlotReadNotification::Ptr>> estimations;
+	auto knownThroughputs = 0u;
+	auto sumThroughputs = 0.0;
+
+	for (const auto& notification : notifications)
+	{
+		Poco::UInt64 bytes = 0;
+
+		for (const auto& plotFile : notification->plotList)
+			bytes += plotFile->getSize() / Settings::PlotSize * Settings::ScoopSize;
+
+		for (const auto& relatedPlotList : notification->relatedPlotLists)
+			for (const auto& plotFile : relatedPlotList.second)
+				bytes += plotFile->getSize() / Settings::PlotSize * Settings::ScoopSize;
+
+		const auto throughput = data_.getPlotDirThroughput(notification->dir);
+
+		if (throughput > 0)
+		{
+			++knownThroughputs;
+			sumThroughputs += throughput;
+		}
+
+		estimations.emplace_back(static_cast<double>(bytes), notification);
+	}
+
+	// directories, that were never read, are assumed to be as fast as the average directory
+	const auto averageThroughput = knownThroughputs > 0 ? sumThroughputs / knownThroughputs : 1.0;
+
+	for (auto& estimation : estimations)
+	{
+		const auto throughput = data_.getPlotDirThroughput(estimation.second->dir);
+		estimation.first /= throughput > 0 ? throughput : averageThroughput;
+	}
+
+	// longest processing time first, the short directories fill the gaps at the end of the round
+	std::stable_sort(estimations.begin(), estimations.end(), [](const auto& lhs, const auto& rhs)
+	{
+		return lhs.first > rhs.first;
+	});
+
+	for (size_t i = 0; i < estimations.size(); ++i)
+		notifications[i] = estimations[i].second;
 }
 
 bool Burst::Miner::wantRestart() const
@@ -267,20 +383,36 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 	CLEAR_PROBES()
 	START_PROBE("Miner.StartNewBlock")
 
+	// the plot cache builder and the plot converter must not slow down the plot readers
+	// (the converter finishes the write of its current block, so the readers never see a half swapped block)
+	for (const auto& manager : {plotCacheBuilder_.get(), plotConverter_.get()})
+	{
+		if (manager != nullptr)
+		{
+			manager->cancelAll();
+			manager->joinAll();
+		}
+	}
+
 	// stop all reading processes if any
 	if (!MinerConfig::getConfig().getPlotFiles().empty())
 	{
 		log_debug(MinerLogger::miner, "Plot-read-queue: %d (%d reader), verification-queue: %d (%d verifier)",
-			plotReadQueue_.size(), plot_reader_->count(), verificationQueue_.size(), verifier_->count());
-		log_debug(MinerLogger::miner, "Allocated memory: %s", memToString(PlotReader::globalBufferSize.getSize(), 1));
+			plotReadScheduler_.size(), plot_reader_->count(), verificationQueue_.size(), verifier_->count());
+		log_debug(MinerLogger::miner, "Allocated memory: %s (arena: %s)", memToString(PlotReader::globalBufferSize.getSize(), 1),
+			memToString(PlotReader::bufferArena.getAllocatedSize(), 1));
+		log_debug(MinerLogger::miner, "Plot readers waited %Lu times for memory (%Lu ms)",
+			PlotReader::globalBufferSize.getWaitCount(), PlotReader::globalBufferSize.getWaitTime() / 1000);
+		PlotReader::globalBufferSize.resetWaitStatistics();
 	
 		START_PROBE("Miner.SetBuffersize")
 		PlotReader::globalBufferSize.setMax(MinerConfig::getConfig().getMaxBufferSize());
+		PlotReader::bufferArena.configure(MinerConfig::getConfig().getMaxBufferSize(), MinerConfig::getConfig().getBufferChunkCount());
 		TAKE_PROBE("Miner.SetBuffersize")
 	}
 	
 	// clear the plot read queue
-	plotReadQueue_.clear();
+	plotReadScheduler_.clear();
 
 	// Set dynamic targetDL for this round if a submitProbability is given
 	if (MinerConfig::getConfig().getSubmitProbability() > 0.)
@@ -313,6 +445,8 @@ void Burst::Miner::updateGensig(const std::string& gensigStr, Poco::UInt64 block
 	// setup new block-data
 	auto block = data_.startNewBlock(blockHeight, baseTarget, gensigStr, MinerConfig::getConfig().getTargetDeadline(TargetDeadlineType::Local));
 	block->refreshBlockEntry();
+	// every scoop hash of the block starts with the gensig, so hash it only once for all verifiers
+	block->getShabalMidstates()->warmUp(MinerConfig::getConfig().getCpuInstructionSet());
 	setIsProcessing(true);
 
 	// printing block info and transfer it to local server
@@ -594,6 +728,13 @@ bool Burst::Miner::getMiningInfo()
 
 					updateGensig(gensig, newBlockHeight, std::stoull(baseTargetStr));
 				}
+				// the same block, but a competing fork tip
+				else if (MinerConfig::getConfig().isMultiGensig() &&
+					newBlockHeight == data_.getBlockData()->getBlockheight() &&
+					root->has("generationSignature"))
+				{
+					addForkGensig(root->get("generationSignature").convert<std::string>());
+				}
 			}
 
 			transferSession(response, miningInfoSession_);
@@ -614,7 +755,8 @@ bool Burst::Miner::getMiningInfo()
 	return false;
 }
 
-void Burst::Miner::shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager, Poco::NotificationQueue& queue) const
+template <typename TQueue>
+void Burst::Miner::shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager, TQueue& queue) const
 {
 	Poco::Mutex::ScopedLock lock(worker_mutex_);
 	queue.wakeUpAll();
@@ -706,6 +848,60 @@ void Burst::Miner::onRoundProcessed(Poco::UInt64 blockHeight, double roundTime)
 		numberToString(block->getBlockheight()),
 		Poco::NumberFormatter::format(roundTime, 3),
 		bestDeadline == nullptr ? "none" : deadlineFormat(bestDeadline->getDeadline()));
+
+	block->getForkGensigs()->forResults([](const ForkGensigs::Fork& fork, const ForkGensigs::Result& result)
+	{
+		log_information(MinerLogger::miner, "Fork tip %s\n"
+			"\tbest deadline:  %s",
+			fork.gensigStr,
+			result.deadline == 0 ? std::string("none") :
+				deadlineFormat(result.deadline) + " (nonce " + numberToString(result.nonce) + ")");
+	});
+
+	// the disks are idle until the next block, so the missing copies of the plot cache are built now
+	if (plotCacheBuilder_ != nullptr && plotCacheBuilder_->count() == 0)
+		plotCacheBuilder_->start(new PlotCacheBuilder);
+
+	// a converted plot file is read without its mirror scoops, what only helps after the PoC2 fork
+	if (plotConverter_ != nullptr && plotConverter_->count() == 0 && isPoC2())
+		plotConverter_->start(new PlotConverterTask);
+}
+
+void Burst::Miner::addForkGensig(const std::string& gensigStr)
+{
+	const auto block = data_.getBlockData();
+
+	if (block == nullptr || gensigStr == block->getGensigStr() || block->getForkGensigs()->isKnown(gensigStr))
+		return;
+
+	GensigData gensig;
+
+	try
+	{
+		if (gensigStr.size() != gensig.size() * 2)
+			throw std::invalid_argument{"wrong length"};
+
+		for (size_t i = 0; i < gensig.size(); ++i)
+			gensig[i] = static_cast<uint8_t>(std::stoi(gensigStr.substr(i * 2, 2), nullptr, 16));
+	}
+	catch (std::exception&)
+	{
+		log_debug(MinerLogger::miner, "Ignoring the invalid gensig of a fork tip: %s", gensigStr);
+		return;
+	}
+
+	const auto sameScoop = BlockData::calculateScoop(gensig, block->getBlockheight()) == block->getScoop();
+
+	if (block->getForkGensigs()->add(gensigStr, gensig, sameScoop, MinerConfig::getConfig().getMultiGensigMaxForks()))
+		log_information(MinerLogger::miner, "Fork tip at block %s\n"
+			"\tgensig:         %s\n"
+			"\tverified with the same reads",
+			numberToString(block->getBlockheight()), gensigStr);
+	else
+		log_debug(MinerLogger::miner, "Fork tip at block %s is not verified (%s)\n"
+			"\tgensig:         %s",
+			numberToString(block->getBlockheight()),
+			std::string(sameScoop ? "too many fork tips" : "other scoop"), gensigStr);
 }
 
 Burst::NonceConfirmation Burst::Miner::submitNonceAsyncImpl(const std::tuple<Poco::UInt64, Poco::UInt64, Poco::UInt64, Poco::UInt64, std::string, bool>& data)
@@ -760,9 +956,16 @@ void Burst::Miner::createPlotVerifiers()
 {
 	const auto& processorType = MinerConfig::getConfig().getProcessorType();
 	auto cpuInstructionSet = MinerConfig::getConfig().getCpuInstructionSet();
-	auto forceCpu = false, fallback = false;
+	auto forceCpu = false, fallback = false, gpu = false;
+
+	// only the cpu verifiers can be fused with the plot readers
+	fusedVerifier_.setFunction(nullptr);
+
+	// the old verifiers are gone, the new ones take over their work
+	verificationQueue_.resetWorkers();
+
 	auto createWorker = [this](std::function<void(std::unique_ptr<Poco::ThreadPool>&, std::unique_ptr<Poco::TaskManager>&,
-	                                              size_t, Miner&, Poco::NotificationQueue&,
+	                                              size_t, Miner&, VerificationQueue&,
 	                                              std::shared_ptr<PlotReadProgress>)> function) {
 		function(verifier_pool_, verifier_, MinerConfig::getConfig().getMiningIntensity(), *this, verificationQueue_,
 		         progressVerify_);
@@ -771,32 +974,32 @@ void Burst::Miner::createPlotVerifiers()
 	if (processorType == "CUDA")
 	{
 		if (Settings::Cuda)
+		{
 			createWorker(MinerHelper::create_worker_default<PlotVerifier_cuda>);
+			gpu = true;
+		}
 		else
 			forceCpu = true;
 	}
 	else if (processorType == "OPENCL")
 	{
 		if (Settings::OpenCl)
+		{
 			createWorker(MinerHelper::create_worker_default<PlotVerifier_opencl>);
+			gpu = true;
+		}
 		else
 			forceCpu = true;
 	}
-
-	if (processorType == "CPU" || forceCpu)
+	else if (processorType == "SIMULATED_GPU")
 	{
-		if (cpuInstructionSet == "SSE4" && Settings::Sse4)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_sse4>);
-		else if (cpuInstructionSet == "AVX" && Settings::Avx)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_avx>);
-		else if (cpuInstructionSet == "AVX2" && Settings::Avx2)
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_avx2>);
-		else if (cpuInstructionSet == "SSE2")
-			createWorker(MinerHelper::create_worker_default<PlotVerifier_sse2>);
-		else
-			fallback = true;
+		createWorker(MinerHelper::create_worker_default<PlotVerifier_simulatedGpu>);
+		gpu = true;
 	}
 
+	if (processorType == "CPU" || forceCpu)
+		fallback = !createCpuVerifiers(cpuInstructionSet, false);
+
 	if (fallback)
 		cpuInstructionSet = "SSE2";
 
@@ -807,8 +1010,49 @@ void Burst::Miner::createPlotVerifiers()
 			"As a fallback solution your CPU with the instruction set %s is used.", processorType, MinerConfig::getConfig().
 			getCpuInstructionSet(), cpuInstructionSet);
 		
-		createWorker(MinerHelper::create_worker_default<PlotVerifier_sse2>);
+		createCpuVerifiers<PlotVerifier_sse2>(false);
 	}
+	// the cpu verifiers work next to the gpu verifiers on the same queue (only, if there are gpu verifiers)
+	else if (gpu && MinerConfig::getConfig().isHybridVerification() && !createCpuVerifiers(cpuInstructionSet, true))
+	{
+		createCpuVerifiers<PlotVerifier_sse2>(true);
+	}
+}
+
+bool Burst::Miner::createCpuVerifiers(const std::string& cpuInstructionSet, const bool hybrid)
+{
+	if (cpuInstructionSet == "SSE4" && Settings::Sse4)
+		createCpuVerifiers<PlotVerifier_sse4>(hybrid);
+	else if (cpuInstructionSet == "AVX" && Settings::Avx)
+		createCpuVerifiers<PlotVerifier_avx>(hybrid);
+	else if (cpuInstructionSet == "AVX2" && Settings::Avx2)
+		createCpuVerifiers<PlotVerifier_avx2>(hybrid);
+	else if (cpuInstructionSet == "AVX512F" && Settings::Avx512)
+		createCpuVerifiers<PlotVerifier_avx512>(hybrid);
+	else if (cpuInstructionSet == "SSE2")
+		createCpuVerifiers<PlotVerifier_sse2>(hybrid);
+	else
+		return false;
+
+	return true;
+}
+
+template <typename TVerifier>
+void Burst::Miner::createCpuVerifiers(const bool hybrid)
+{
+	if (hybrid)
+	{
+		MinerHelper::add_worker<TVerifier>(*verifier_pool_, *verifier_, MinerConfig::getConfig().getHybridCpuThreads(),
+			*this, verificationQueue_, progressVerify_);
+		return;
+	}
+
+	MinerHelper::create_worker_default<TVerifier>(verifier_pool_, verifier_, MinerConfig::getConfig().getMiningIntensity(),
+		*this, verificationQueue_, progressVerify_);
+
+	if (MinerConfig::getConfig().isFusedVerification())
+		fusedVerifier_.setFunction(MinerHelper::create_fused_verifier<TVerifier>(*this, progressVerify_,
+			MinerConfig::getConfig().getFusedVerificationChunkSize() / Settings::ScoopSize));
 }
 
 void Burst::Miner::setMiningIntensity(unsigned intensity)
@@ -834,16 +1078,17 @@ void Burst::Miner::setMaxPlotReader(unsigned max_reader)
 	if (MinerConfig::getConfig().getMaxPlotReaders() == max_reader)
 		return;
 
-	shut_down_worker(*plot_reader_pool_, *plot_reader_, plotReadQueue_);
+	shut_down_worker(*plot_reader_pool_, *plot_reader_, plotReadScheduler_);
 	MinerConfig::getConfig().setMaxPlotReaders(max_reader);
 	MinerHelper::create_worker<PlotReader>(plot_reader_pool_, plot_reader_, MinerConfig::getConfig().getMaxPlotReaders(),
-		data_, progressRead_, verificationQueue_, plotReadQueue_);
+		data_, progressRead_, progressVerify_, verificationQueue_, fusedVerifier_, plotReadScheduler_);
 }
 
 void Burst::Miner::setMaxBufferSize(Poco::UInt64 size)
 {
 	MinerConfig::getConfig().setBufferSize(size);
 	PlotReader::globalBufferSize.setMax(size);
+	PlotReader::bufferArena.configure(size, MinerConfig::getConfig().getBufferChunkCount());
 }
 
 void Burst::Miner::rescanPlotfiles()
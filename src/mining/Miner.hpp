@@ -29,6 +29,8 @@
 #include <Poco/TaskManager.h>
 #include "MinerData.hpp"
 #include <Poco/NotificationQueue.h>
+#include "plots/PlotReadScheduler.hpp"
+#include "plots/VerificationQueue.hpp"
 #include "WorkerList.hpp"
 #include "network/Response.hpp"
 #include <Poco/Timer.h>
@@ -98,22 +100,51 @@ namespace Burst
 		SubmitResponse addNewDeadline(Poco::UInt64 nonce, Poco::UInt64 accountId, Poco::UInt64 deadline,
 		                              Poco::UInt64 blockheight, std::string plotFile,
 		                              bool ownAccount, std::shared_ptr<Deadline>& newDeadline);
-		void shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager,
-		                      Poco::NotificationQueue& queue) const;
+
+		/**
+		 * \brief Orders the plot read notifications by their estimated read time, the longest first.
+		 * \param notifications The notifications, that will be ordered.
+		 */
+		void orderPlotReadNotifications(std::vector<PlotReadNotification::Ptr>& notifications) const;
+
+		template <typename TQueue>
+		void shut_down_worker(Poco::ThreadPool& thread_pool, Poco::TaskManager& task_manager, TQueue& queue) const;
 		void progressChanged(float& progress);
 		void on_wake_up(Poco::Timer& timer);
 		void onBenchmark(Poco::Timer& timer);
 		void onRoundProcessed(Poco::UInt64 blockHeight, double roundTime);
 
+		/**
+		 * \brief Adds the gensig of a competing fork tip at the height of the current block.
+		 * \param gensigStr The gensig of the fork tip as a hex string.
+		 */
+		void addForkGensig(const std::string& gensigStr);
+
+		/**
+		 * \brief Creates the CPU verifiers for an instruction set.
+		 * \param cpuInstructionSet The instruction set.
+		 * \param hybrid If true, the verifiers are added to the running GPU verifiers.
+		 * \return false, if the instruction set is not supported.
+		 */
+		bool createCpuVerifiers(const std::string& cpuInstructionSet, bool hybrid);
+
+		/**
+		 * \brief Creates the CPU verifiers and, in the fused mode, lets the plot readers verify with the same algorithm.
+		 * \param hybrid If true, the verifiers are added to the running GPU verifiers.
+		 */
+		template <typename TVerifier>
+		void createCpuVerifiers(bool hybrid);
+
 		bool running_ = false, restart_ = false, isProcessing_ = false;
 		MinerData data_;
 		std::shared_ptr<PlotReadProgress> progressRead_, progressVerify_;
 		std::unique_ptr<Poco::Net::HTTPClientSession> miningInfoSession_;
 		Accounts accounts_;
 		Wallet wallet_;
-		std::unique_ptr<Poco::TaskManager> nonceSubmitterManager_, plot_reader_, verifier_;
-		Poco::NotificationQueue plotReadQueue_;
-		Poco::NotificationQueue verificationQueue_;
+		std::unique_ptr<Poco::TaskManager> nonceSubmitterManager_, plot_reader_, verifier_, plotCacheBuilder_, plotConverter_;
+		PlotReadScheduler plotReadScheduler_;
+		VerificationQueue verificationQueue_;
+		FusedVerifier fusedVerifier_;
 		std::unique_ptr<Poco::ThreadPool> verifier_pool_, plot_reader_pool_;
 		Poco::Timer wake_up_timer_, benchmark_timer_;
 		mutable Poco::Mutex worker_mutex_;
@@ -24,6 +24,7 @@
 #include "MinerUtil.hpp"
 #include <fstream>
 #include <memory>
+#include <thread>
 #include <Poco/File.h>
 #include <Poco/Path.h>
 #include <Poco/JSON/Parser.h>
@@ -37,6 +38,8 @@
 #include "logging/Output.hpp"
 #include "plots/PlotReader.hpp"
 #include "plots/Plot.hpp"
+#include "plots/VerifierBenchmark.hpp"
+#include "ForkGensigs.hpp"
 #include <Poco/FileStream.h>
 #include <Poco/JSON/PrintHandler.h>
 #include <Poco/StringTokenizer.h>
@@ -153,11 +156,34 @@ void Burst::MinerConfig::printConsole() const
 
 	log_system(MinerLogger::config, "Processor type : %s", getConfig().getProcessorType());
 
-	if (getConfig().getProcessorType() == "CPU")
+	if (getConfig().getProcessorType() == "CPU" || getConfig().isHybridVerification())
 		log_system(MinerLogger::config, "CPU instruction set : %s", getConfig().getCpuInstructionSet());
+
+	if (getConfig().isHybridVerification())
+		log_system(MinerLogger::config, "Hybrid verification : %u CPU verifiers", getConfig().getHybridCpuThreads());
+
+	if (getConfig().isMultiGensig())
+		log_system(MinerLogger::config, "Multi gensig : up to %z fork tips", getConfig().getMultiGensigMaxForks());
 	
 	if (getConfig().isBenchmark())
 		log_warning(MinerLogger::config, "Benchmark mode activated!");
+
+	if (getConfig().isEarlyExit())
+		log_system(MinerLogger::config, "Early exit : below %s", deadlineFormat(getConfig().getEarlyExitDeadline()));
+
+	if (getConfig().isDroppingDeadlinesAboveTarget())
+		log_system(MinerLogger::config, "Deadlines above the target deadline are dropped");
+
+	if (!getConfig().getPlotCacheDir().empty())
+		log_system(MinerLogger::config, "Plot cache : %s (%s)", getConfig().getPlotCacheDir(),
+			getConfig().getPlotCacheMaxSize() > 0 ? memToString(getConfig().getPlotCacheMaxSize(), 0) : std::string("unlimited"));
+
+	if (getConfig().isPoC2Conversion())
+		log_system(MinerLogger::config, "PoC2 conversion : %s", getConfig().getPoC2ConversionMaxSpeed() > 0 ?
+			memToString(getConfig().getPoC2ConversionMaxSpeed(), 0) + "/s" : std::string("unlimited"));
+
+	if (getConfig().isFusedVerification())
+		log_system(MinerLogger::config, "Fused verification : sub chunks of %s", memToString(getConfig().getFusedVerificationChunkSize(), 0));
 }
 
 void Burst::MinerConfig::printConsolePlots() const
@@ -199,6 +225,25 @@ void Burst::MinerConfig::printBufferChunks() const
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	log_system(MinerLogger::config, "Buffer Chunks : %s", std::to_string(getBufferChunkCount()));
+	log_system(MinerLogger::config, "Read queue depth : %u", getReadQueueDepth());
+	log_system(MinerLogger::config, "Direct IO : %s", std::string(isDirectIo() ? "on" : "off"));
+	log_system(MinerLogger::config, "Read order : %s", getReadOrder());
+
+	if (isNumaAware())
+	{
+		const auto nodesToString = [](const std::vector<size_t>& nodes)
+		{
+			std::string str;
+
+			for (const auto node : nodes)
+				str += (str.empty() ? "" : ", ") + std::to_string(node);
+
+			return str.empty() ? std::string("all") : str;
+		};
+
+		log_system(MinerLogger::config, "NUMA nodes : readers on %s, verifiers on %s",
+			nodesToString(getNumaReaderNodes()), nodesToString(getNumaVerifierNodes()));
+	}
 }
 
 template <typename T>
@@ -481,29 +526,41 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 		useInsecurePlotfiles_ = getOrAdd(miningObj, "useInsecurePlotfiles", false);
 		getMiningInfoInterval_ = getOrAdd(miningObj, "getMiningInfoInterval", 3);
 		rescanEveryBlock_ = getOrAdd(miningObj, "rescanEveryBlock", false);
+		dropDeadlinesAboveTarget_ = getOrAdd(miningObj, "dropDeadlinesAboveTarget", false);
 		
 		bufferChunkCount_ = getOrAdd(miningObj, "bufferChunkCount", 8);
+		readQueueDepth_ = getOrAdd(miningObj, "readQueueDepth", 4);
+		directIo_ = getOrAdd(miningObj, "directIo", false);
+		readOrder_ = getOrAdd(miningObj, "readOrder", std::string("longestFirst"));
+
+		if (readOrder_ != "longestFirst" && readOrder_ != "config")
+		{
+			log_warning(MinerLogger::config, "The read order %s is unknown (longestFirst, config)!\n"
+				"The default read order longestFirst is used instead.", readOrder_);
+			readOrder_ = "longestFirst";
+		}
+
 		wakeUpTime_ = getOrAdd(miningObj, "wakeUpTime", 0);
 
-		cpuInstructionSet_ = Poco::toUpper(getOrAdd(miningObj, "cpuInstructionSet", std::string("SSE2")));
+		// without a configured instruction set, the fastest one of the node is taken
+		cpuInstructionSet_ = Poco::toUpper(getOrAdd(miningObj, "cpuInstructionSet", std::string("AUTO")));
 		cpuInstructionSet_ = Poco::trim(cpuInstructionSet_);
 
 		databasePath_ = getOrAdd(miningObj, "databasePath", std::string("data.db"));
 		poc2StartBlock_ = getOrAdd(miningObj, "poc2StartBlock", 502000);
 
-		// auto detect the max. cpu instruction set
-		if (cpuInstructionSet_ == "AUTO")
+		// a configured instruction set, that can not be used, would end in the (slow) SSE2 fallback
+		if (cpuInstructionSet_ != "AUTO" && !VerifierBenchmark::isAvailable(cpuInstructionSet_))
 		{
-			if (cpuHasInstructionSet(CpuInstructionSet::avx2))
-				cpuInstructionSet_ = "AVX2";
-			else if (cpuHasInstructionSet(CpuInstructionSet::avx))
-				cpuInstructionSet_ = "AVX";
-			else if (cpuHasInstructionSet(CpuInstructionSet::sse4))
-				cpuInstructionSet_ = "SSE4";
-			else
-				cpuInstructionSet_ = "SSE2";
+			log_warning(MinerLogger::config, "The CPU instruction set %s is not supported by your CPU or the miner is compiled without it!\n"
+				"The fastest available instruction set is used instead.", cpuInstructionSet_);
+			cpuInstructionSet_ = "AUTO";
 		}
 
+		// benchmark all available cpu instruction sets and take the fastest one
+		if (cpuInstructionSet_ == "AUTO")
+			cpuInstructionSet_ = VerifierBenchmark::findFastestInstructionSet();
+
 		Settings::setCpuInstructionSet(cpuInstructionSet_);
 
 		processorType_ = getOrAdd(miningObj, "processorType", std::string("CPU"));
@@ -526,6 +583,134 @@ Burst::ReadConfigFileResult Burst::MinerConfig::readConfigFile(const std::string
 			miningObj->set("benchmark", benchmarkObj);
 		}
 
+		// early exit
+		{
+			Poco::JSON::Object::Ptr earlyExitObj;
+
+			if (miningObj->has("earlyExit"))
+				earlyExitObj = miningObj->get("earlyExit").extract<Poco::JSON::Object::Ptr>();
+			else
+				earlyExitObj = new Poco::JSON::Object;
+
+			earlyExit_ = getOrAdd(earlyExitObj, "active", false);
+			earlyExitDeadline_ = formatDeadline(getOrAdd(earlyExitObj, "deadline", deadlineFormat(240)));
+			earlyExitTargetDeadlineFactor_ = getOrAdd(earlyExitObj, "targetDeadlineFactor", 0.0);
+
+			miningObj->set("earlyExit", earlyExitObj);
+		}
+
+		// plot cache
+		{
+			Poco::JSON::Object::Ptr plotCacheObj;
+
+			if (miningObj->has("plotCache"))
+				plotCacheObj = miningObj->get("plotCache").extract<Poco::JSON::Object::Ptr>();
+			else
+				plotCacheObj = new Poco::JSON::Object;
+
+			plotCacheDir_ = getOrAdd(plotCacheObj, "dir", std::string());
+			plotCacheMaxSizeGB_ = getOrAdd(plotCacheObj, "maxSizeGB", 0u);
+
+			miningObj->set("plotCache", plotCacheObj);
+		}
+
+		// poc2 conversion
+		{
+			Poco::JSON::Object::Ptr poc2ConversionObj;
+
+			if (miningObj->has("poc2Conversion"))
+				poc2ConversionObj = miningObj->get("poc2Conversion").extract<Poco::JSON::Object::Ptr>();
+			else
+				poc2ConversionObj = new Poco::JSON::Object;
+
+			poc2Conversion_ = getOrAdd(poc2ConversionObj, "active", false);
+			poc2ConversionMaxSpeedMB_ = getOrAdd(poc2ConversionObj, "maxSpeedMB", 0u);
+
+			miningObj->set("poc2Conversion", poc2ConversionObj);
+		}
+
+		// fused verification
+		{
+			Poco::JSON::Object::Ptr fusedVerificationObj;
+
+			if (miningObj->has("fusedVerification"))
+				fusedVerificationObj = miningObj->get("fusedVerification").extract<Poco::JSON::Object::Ptr>();
+			else
+				fusedVerificationObj = new Poco::JSON::Object;
+
+			fusedVerification_ = getOrAdd(fusedVerificationObj, "active", false);
+			fusedVerificationChunkSizeKB_ = std::max(getOrAdd(fusedVerificationObj, "chunkSizeKB", 256u), 1u);
+
+			miningObj->set("fusedVerification", fusedVerificationObj);
+		}
+
+		// hybrid verification
+		{
+			Poco::JSON::Object::Ptr hybridObj;
+
+			if (miningObj->has("hybrid"))
+				hybridObj = miningObj->get("hybrid").extract<Poco::JSON::Object::Ptr>();
+			else
+				hybridObj = new Poco::JSON::Object;
+
+			hybridVerification_ = getOrAdd(hybridObj, "active", false);
+			hybridCpuThreads_ = getOrAdd(hybridObj, "cpuThreads", 0u);
+
+			miningObj->set("hybrid", hybridObj);
+		}
+
+		// multi gensig
+		{
+			Poco::JSON::Object::Ptr multiGensigObj;
+
+			if (miningObj->has("multiGensig"))
+				multiGensigObj = miningObj->get("multiGensig").extract<Poco::JSON::Object::Ptr>();
+			else
+				multiGensigObj = new Poco::JSON::Object;
+
+			multiGensig_ = getOrAdd(multiGensigObj, "active", false);
+			multiGensigMaxForks_ = getOrAdd(multiGensigObj, "maxForks", 3u);
+
+			miningObj->set("multiGensig", multiGensigObj);
+		}
+
+		// numa
+		{
+			Poco::JSON::Object::Ptr numaObj;
+
+			if (miningObj->has("numa"))
+				numaObj = miningObj->get("numa").extract<Poco::JSON::Object::Ptr>();
+			else
+				numaObj = new Poco::JSON::Object;
+
+			numaAware_ = getOrAdd(numaObj, "active", false);
+
+			const auto readNodes = [&numaObj](const std::string& key, std::vector<size_t>& nodes)
+			{
+				const Poco::JSON::Array::Ptr arr(new Poco::JSON::Array);
+				auto nodesJson = getOrAddExtract(numaObj, key, arr);
+
+				nodes.clear();
+
+				for (const auto& node : *nodesJson)
+				{
+					try
+					{
+						nodes.emplace_back(static_cast<size_t>(node.convert<Poco::UInt64>()));
+					}
+					catch (...)
+					{
+						log_error(MinerLogger::config, "Invalid NUMA node in config: %s", node.toString());
+					}
+				}
+			};
+
+			readNodes("readerNodes", numaReaderNodes_);
+			readNodes("verifierNodes", numaVerifierNodes_);
+
+			miningObj->set("numa", numaObj);
+		}
+
 		// urls
 		{
 			Poco::JSON::Object::Ptr urlsObj;
@@ -1388,6 +1573,92 @@ long Burst::MinerConfig::getBenchmarkInterval() const
 	return benchmarkInterval_;
 }
 
+bool Burst::MinerConfig::isEarlyExit() const
+{
+	return earlyExit_;
+}
+
+Poco::UInt64 Burst::MinerConfig::getEarlyExitDeadline() const
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+	const auto targetDeadline = getTargetDeadline(TargetDeadlineType::Combined);
+	const auto targetDeadlineFraction = static_cast<Poco::UInt64>(targetDeadline * earlyExitTargetDeadlineFactor_);
+	return std::max(earlyExitDeadline_, targetDeadlineFraction);
+}
+
+bool Burst::MinerConfig::isDroppingDeadlinesAboveTarget() const
+{
+	return dropDeadlinesAboveTarget_;
+}
+
+const std::string& Burst::MinerConfig::getPlotCacheDir() const
+{
+	return plotCacheDir_;
+}
+
+Poco::UInt64 Burst::MinerConfig::getPlotCacheMaxSize() const
+{
+	return plotCacheMaxSizeGB_ * 1024 * 1024 * 1024;
+}
+
+bool Burst::MinerConfig::isPoC2Conversion() const
+{
+	return poc2Conversion_;
+}
+
+Poco::UInt64 Burst::MinerConfig::getPoC2ConversionMaxSpeed() const
+{
+	return poc2ConversionMaxSpeedMB_ * 1024 * 1024;
+}
+
+bool Burst::MinerConfig::isFusedVerification() const
+{
+	return fusedVerification_;
+}
+
+Poco::UInt64 Burst::MinerConfig::getFusedVerificationChunkSize() const
+{
+	return fusedVerificationChunkSizeKB_ * 1024;
+}
+
+bool Burst::MinerConfig::isHybridVerification() const
+{
+	return hybridVerification_ && getProcessorType() != "CPU";
+}
+
+unsigned Burst::MinerConfig::getHybridCpuThreads() const
+{
+	if (hybridCpuThreads_ == 0)
+		return std::max(std::thread::hardware_concurrency(), 1u);
+
+	return hybridCpuThreads_;
+}
+
+bool Burst::MinerConfig::isMultiGensig() const
+{
+	return multiGensig_ && multiGensigMaxForks_ > 0;
+}
+
+size_t Burst::MinerConfig::getMultiGensigMaxForks() const
+{
+	return std::min<size_t>(multiGensigMaxForks_, ForkGensigs::MaxForks);
+}
+
+bool Burst::MinerConfig::isNumaAware() const
+{
+	return numaAware_;
+}
+
+const std::vector<size_t>& Burst::MinerConfig::getNumaReaderNodes() const
+{
+	return numaReaderNodes_;
+}
+
+const std::vector<size_t>& Burst::MinerConfig::getNumaVerifierNodes() const
+{
+	return numaVerifierNodes_;
+}
+
 unsigned Burst::MinerConfig::getGpuPlatform() const
 {
 	return gpuPlatform_;
@@ -1477,7 +1748,11 @@ bool Burst::MinerConfig::save(const std::string& path) const
 		mining.set("walletRequestTries", walletRequestTries_);
 		mining.set("useInsecurePlotfiles", useInsecurePlotfiles());
 		mining.set("rescanEveryBlock", isRescanningEveryBlock());
+		mining.set("dropDeadlinesAboveTarget", isDroppingDeadlinesAboveTarget());
 		mining.set("bufferChunkCount", getBufferChunkCount());
+		mining.set("readQueueDepth", getReadQueueDepth());
+		mining.set("directIo", isDirectIo());
+		mining.set("readOrder", getReadOrder());
 		mining.set("wakeUpTime", getWakeUpTime());
 		mining.set("cpuInstructionSet", getCpuInstructionSet());
 		mining.set("processorType", getProcessorType());
@@ -1493,6 +1768,72 @@ bool Burst::MinerConfig::save(const std::string& path) const
 			mining.set("benchmark", benchmark);
 		}
 
+		// early exit
+		{
+			Poco::JSON::Object earlyExit;
+			earlyExit.set("active", isEarlyExit());
+			earlyExit.set("deadline", deadlineFormat(earlyExitDeadline_));
+			earlyExit.set("targetDeadlineFactor", earlyExitTargetDeadlineFactor_);
+			mining.set("earlyExit", earlyExit);
+		}
+
+		// plot cache
+		{
+			Poco::JSON::Object plotCache;
+			plotCache.set("dir", getPlotCacheDir());
+			plotCache.set("maxSizeGB", plotCacheMaxSizeGB_);
+			mining.set("plotCache", plotCache);
+		}
+
+		// poc2 conversion
+		{
+			Poco::JSON::Object poc2Conversion;
+			poc2Conversion.set("active", isPoC2Conversion());
+			poc2Conversion.set("maxSpeedMB", poc2ConversionMaxSpeedMB_);
+			mining.set("poc2Conversion", poc2Conversion);
+		}
+
+		// fused verification
+		{
+			Poco::JSON::Object fusedVerification;
+			fusedVerification.set("active", isFusedVerification());
+			fusedVerification.set("chunkSizeKB", fusedVerificationChunkSizeKB_);
+			mining.set("fusedVerification", fusedVerification);
+		}
+
+		// hybrid verification
+		{
+			Poco::JSON::Object hybrid;
+			hybrid.set("active", hybridVerification_);
+			hybrid.set("cpuThreads", hybridCpuThreads_);
+			mining.set("hybrid", hybrid);
+		}
+
+		// multi gensig
+		{
+			Poco::JSON::Object multiGensig;
+			multiGensig.set("active", multiGensig_);
+			multiGensig.set("maxForks", multiGensigMaxForks_);
+			mining.set("multiGensig", multiGensig);
+		}
+
+		// numa
+		{
+			Poco::JSON::Object numa;
+			Poco::JSON::Array readerNodes, verifierNodes;
+
+			for (const auto node : getNumaReaderNodes())
+				readerNodes.add(static_cast<Poco::UInt64>(node));
+
+			for (const auto node : getNumaVerifierNodes())
+				verifierNodes.add(static_cast<Poco::UInt64>(node));
+
+			numa.set("active", isNumaAware());
+			numa.set("readerNodes", readerNodes);
+			numa.set("verifierNodes", verifierNodes);
+			mining.set("numa", numa);
+		}
+
 		// passphrase
 		{
 			Poco::JSON::Object passphrase;
@@ -1695,12 +2036,24 @@ void Burst::MinerConfig::setBufferChunkCount(unsigned bufferChunkCount)
 	bufferChunkCount_ = bufferChunkCount;
 }
 
+void Burst::MinerConfig::setReadQueueDepth(unsigned readQueueDepth)
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+	readQueueDepth_ = readQueueDepth;
+}
+
 void Burst::MinerConfig::setPoolTargetDeadline(Poco::UInt64 targetDeadline)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
 	targetDeadlinePool_ = targetDeadline;
 }
 
+void Burst::MinerConfig::setReadOrder(const std::string& readOrder)
+{
+	Poco::Mutex::ScopedLock lock(mutex_);
+	readOrder_ = readOrder;
+}
+
 void Burst::MinerConfig::setProcessorType(const std::string& processorType)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
@@ -1850,6 +2203,21 @@ unsigned Burst::MinerConfig::getBufferChunkCount() const
 	return bufferChunkCount_;
 }
 
+unsigned Burst::MinerConfig::getReadQueueDepth() const
+{
+	return readQueueDepth_;
+}
+
+bool Burst::MinerConfig::isDirectIo() const
+{
+	return directIo_;
+}
+
+const std::string& Burst::MinerConfig::getReadOrder() const
+{
+	return readOrder_;
+}
+
 void Burst::MinerConfig::useLogfile(bool use)
 {
 	Poco::Mutex::ScopedLock lock(mutex_);
@@ -184,6 +184,23 @@ namespace Burst
 		bool isSteadyProgressBar() const;
 		bool isFancyProgressBar() const;
 		unsigned getBufferChunkCount() const;
+
+		/**
+		 * \brief Returns the amount of reads, that every plot reader keeps in flight at the same time.
+		 */
+		unsigned getReadQueueDepth() const;
+
+		/**
+		 * \brief Returns true, if the plot files are read directly from the disk (bypassing the page cache).
+		 */
+		bool isDirectIo() const;
+
+		/**
+		 * \brief Returns the order, in which the plot directories are read.
+		 * "config" reads them in the order of the config file, "longestFirst" reads the directories
+		 * with the longest estimated read time first, so the round does not end with one big directory.
+		 */
+		const std::string& getReadOrder() const;
 		bool isCalculatingEveryDeadline() const;
 
 		/**
@@ -204,6 +221,97 @@ namespace Burst
 		const std::string& getProcessorType() const;
 		bool isBenchmark() const;
 		long getBenchmarkInterval() const;
+
+		/**
+		 * \brief Returns true, if the rest of a round is skipped, when a confirmed deadline is below the early exit deadline.
+		 */
+		bool isEarlyExit() const;
+
+		/**
+		 * \brief Returns the deadline, below which a confirmed deadline ends the round early.
+		 * It is the bigger value of the configured deadline and the fraction of the target deadline.
+		 * \return The deadline in seconds.
+		 */
+		Poco::UInt64 getEarlyExitDeadline() const;
+
+		/**
+		 * \brief Returns true, if the verifiers drop all deadlines above the target deadline.
+		 * Then these deadlines are neither submitted nor shown as found.
+		 */
+		bool isDroppingDeadlinesAboveTarget() const;
+
+		/**
+		 * \brief Returns the directory on a fast disk, where optimized copies of unoptimized plot files are cached.
+		 * An empty string means, that there is no plot cache.
+		 */
+		const std::string& getPlotCacheDir() const;
+
+		/**
+		 * \brief Returns the maximal size of the plot cache.
+		 * \return The size in bytes, 0 means that only the free space of the disk is a limit.
+		 */
+		Poco::UInt64 getPlotCacheMaxSize() const;
+
+		/**
+		 * \brief Returns true, if the PoC1 plot files are converted in place into PoC2 plot files between the rounds.
+		 */
+		bool isPoC2Conversion() const;
+
+		/**
+		 * \brief Returns the maximal speed of the PoC2 conversion (reads and writes).
+		 * \return The speed in bytes per second, 0 means no limit.
+		 */
+		Poco::UInt64 getPoC2ConversionMaxSpeed() const;
+
+		/**
+		 * \brief Returns true, if the plot readers verify the scoops by themselves, right after they are read.
+		 */
+		bool isFusedVerification() const;
+
+		/**
+		 * \brief Returns the size of the sub chunks, that are verified at once in the fused mode.
+		 * It should fit into the L2 cache of one core.
+		 * \return The size in bytes.
+		 */
+		Poco::UInt64 getFusedVerificationChunkSize() const;
+
+		/**
+		 * \brief Returns true, if CPU verifiers are running next to the GPU verifiers.
+		 * Both share the same verification queue, the chunks are routed by the measured throughput.
+		 */
+		bool isHybridVerification() const;
+
+		/**
+		 * \brief Returns the amount of CPU verifiers in the hybrid mode.
+		 * \return The amount (all cores, if it is not set).
+		 */
+		unsigned getHybridCpuThreads() const;
+
+		/**
+		 * \brief Returns true, if the gensigs of competing fork tips at the current height are verified
+		 * together with the gensig of the block (when they select the same scoop).
+		 */
+		bool isMultiGensig() const;
+
+		/**
+		 * \brief Returns the maximal amount of fork tips, that are verified next to the gensig of the block.
+		 */
+		size_t getMultiGensigMaxForks() const;
+
+		/**
+		 * \brief Returns true, if the plot readers and verifiers are pinned to the NUMA nodes.
+		 */
+		bool isNumaAware() const;
+
+		/**
+		 * \brief Returns the NUMA nodes of the plot readers (empty means all nodes).
+		 */
+		const std::vector<size_t>& getNumaReaderNodes() const;
+
+		/**
+		 * \brief Returns the NUMA nodes of the plot verifiers (empty means all nodes).
+		 */
+		const std::vector<size_t>& getNumaVerifierNodes() const;
 		unsigned getGpuPlatform() const;
 		unsigned getGpuDevice() const;
 		unsigned getMaxConnectionsQueued() const;
@@ -227,6 +335,8 @@ namespace Burst
 		void setLogDir(const std::string& log_dir);
 		void setGetMiningInfoInterval(unsigned interval);
 		void setBufferChunkCount(unsigned bufferChunkCount);
+		void setReadQueueDepth(unsigned readQueueDepth);
+		void setReadOrder(const std::string& readOrder);
 		void setPoolTargetDeadline(Poco::UInt64 targetDeadline);
 		void setProcessorType(const std::string& processorType);
 		void setCpuInstructionSet(const std::string& instructionSet);
@@ -303,6 +413,25 @@ namespace Burst
 		Poco::UInt64 maxBufferSizeMB_ = 0;
 		Poco::UInt64 maxHistoricalBlocks_ = 0;
 		unsigned bufferChunkCount_ = 16;
+		unsigned readQueueDepth_ = 4;
+		bool directIo_ = false;
+		std::string readOrder_ = "longestFirst";
+		bool earlyExit_ = false;
+		Poco::UInt64 earlyExitDeadline_ = 240;
+		double earlyExitTargetDeadlineFactor_ = 0.0;
+		bool dropDeadlinesAboveTarget_ = false;
+		std::string plotCacheDir_;
+		Poco::UInt64 plotCacheMaxSizeGB_ = 0;
+		bool poc2Conversion_ = false;
+		Poco::UInt64 poc2ConversionMaxSpeedMB_ = 0;
+		bool fusedVerification_ = false;
+		Poco::UInt64 fusedVerificationChunkSizeKB_ = 256;
+		bool hybridVerification_ = false;
+		unsigned hybridCpuThreads_ = 0;
+		bool multiGensig_ = false;
+		unsigned multiGensigMaxForks_ = 3;
+		bool numaAware_ = false;
+		std::vector<size_t> numaReaderNodes_, numaVerifierNodes_;
 		unsigned walletRequestTries_ = 3;
 		unsigned walletRequestRetryWaitTime_ = 3;
 		Passphrase passphrase_ = {};
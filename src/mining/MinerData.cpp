@@ -23,6 +23,7 @@
 #include "MinerConfig.hpp"
 #include "logging/MinerLogger.hpp"
 #include "shabal/MinerShabal.hpp"
+#include "ForkGensigs.hpp"
 #include "logging/Output.hpp"
 #include "MinerUtil.hpp"
 #include "wallet/Wallet.hpp"
@@ -47,15 +48,11 @@ Burst::BlockData::BlockData(const Poco::UInt64 blockHeight, const Poco::UInt64 b
 		genSig_[i] = static_cast<uint8_t>(std::stoi(byteStr, nullptr, 16));
 	}
 
-	Shabal256_SSE2 hash;
-	GensigData newGenSig;
-	
-	hash.update(&genSig_[0], genSig_.size());
-	hash.update(blockHeight);
-	hash.close(&newGenSig[0]);
+	shabalMidstates_ = std::make_shared<ShabalMidstates>(genSig_);
+	forkGensigs_ = std::make_shared<ForkGensigs>();
 
 	roundTime_ = 0;
-	scoop_ = (static_cast<int>(newGenSig[newGenSig.size() - 2] & 0x0F) << 8) | static_cast<int>(newGenSig[newGenSig.size() - 1]);
+	scoop_ = calculateScoop(genSig_, blockHeight);
 }
 
 std::shared_ptr<Burst::Deadline> Burst::BlockData::addDeadlineUnlocked(const Poco::UInt64 nonce, const Poco::UInt64 deadline,
@@ -106,6 +103,15 @@ void Burst::BlockData::confirmedDeadlineEvent(const std::shared_ptr<Deadline>& d
 			bestDeadline_->getDeadline() > deadline->getDeadline())
 			bestDeadline_ = deadline;
 	}
+
+	// the deadline is good enough, reading the rest of the plots would only cost time and power
+	if (MinerConfig::getConfig().isEarlyExit() && !earlyExit_ &&
+		deadline->getDeadline() < MinerConfig::getConfig().getEarlyExitDeadline())
+	{
+		earlyExit_ = true;
+		log_information(MinerLogger::miner, "Confirmed deadline %s is below %s, skipping the rest of the round",
+			deadline->deadlineToReadableString(), deadlineFormat(MinerConfig::getConfig().getEarlyExitDeadline()));
+	}
 }
 
 Burst::BlockData::DataLoader::DataLoader()
@@ -214,11 +220,15 @@ void Burst::BlockData::setProgress(float progressRead, float progressVerificatio
 		parent_->blockDataChangedEvent.notify(this, *jsonProgress_);
 }
 
-void Burst::BlockData::setProgress(const std::string& plotDir, float progress, Poco::UInt64 blockheight)
+void Burst::BlockData::setProgress(const std::string& plotDir, float progress, Poco::UInt64 blockheight,
+	const Poco::UInt64 bytesRead, const double seconds)
 {
 	if (blockheight != getBlockheight())
 		return;
 
+	if (parent_ != nullptr && bytesRead > 0 && seconds > 0)
+		parent_->addPlotDirThroughput(plotDir, bytesRead / seconds);
+
 	std::lock_guard<std::mutex> lock{ mutex_ };
 	auto json = new Poco::JSON::Object{ createJsonProgress(progress, 0.f) };
 	json->set("type", "plotdir-progress");
@@ -291,11 +301,38 @@ const std::string& Burst::BlockData::getGensigStr() const
 	return genSigStr_;
 }
 
+std::shared_ptr<const Burst::ShabalMidstates> Burst::BlockData::getShabalMidstates() const
+{
+	return shabalMidstates_;
+}
+
+std::shared_ptr<Burst::ForkGensigs> Burst::BlockData::getForkGensigs() const
+{
+	return forkGensigs_;
+}
+
+Poco::UInt64 Burst::BlockData::calculateScoop(const GensigData& gensig, const Poco::UInt64 blockHeight)
+{
+	Shabal256_SSE2 hash;
+	GensigData newGenSig;
+	
+	hash.update(&gensig[0], gensig.size());
+	hash.update(blockHeight);
+	hash.close(&newGenSig[0]);
+
+	return (static_cast<int>(newGenSig[newGenSig.size() - 2] & 0x0F) << 8) | static_cast<int>(newGenSig[newGenSig.size() - 1]);
+}
+
 std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline() const
 {
 	return bestDeadline_;
 }
 
+bool Burst::BlockData::isEarlyExit() const
+{
+	return earlyExit_;
+}
+
 std::shared_ptr<Burst::Deadline> Burst::BlockData::getBestDeadline(const DeadlineSearchType searchType) const
 {
 	std::lock_guard<std::mutex> lock{ mutex_ };
@@ -903,3 +940,24 @@ Poco::ActiveResult<Poco::UInt64> Burst::MinerData::getWonBlocksAsync(const Walle
 	const auto tuple = std::make_pair(&wallet, &accounts);
 	return activityWonBlocks_(tuple);
 }
+
+void Burst::MinerData::addPlotDirThroughput(const std::string& plotDir, const double bytesPerSecond)
+{
+	// the weight of the newest measurement, the older ones fade out
+	const auto alpha = 0.3;
+
+	std::lock_guard<std::mutex> lock{mutex_};
+	auto& throughput = plotDirThroughput_[plotDir];
+
+	if (throughput <= 0)
+		throughput = bytesPerSecond;
+	else
+		throughput = alpha * bytesPerSecond + (1 - alpha) * throughput;
+}
+
+double Burst::MinerData::getPlotDirThroughput(const std::string& plotDir) const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	const auto iter = plotDirThroughput_.find(plotDir);
+	return iter == plotDirThroughput_.end() ? 0 : iter->second;
+}
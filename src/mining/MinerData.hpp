@@ -42,6 +42,8 @@ namespace Burst
 	class Accounts;
 	class Wallet;
 	class Account;
+	class ShabalMidstates;
+	class ForkGensigs;
 
 	class BlockData
 	{
@@ -66,7 +68,17 @@ namespace Burst
 		void refreshConfig() const;
 		void refreshPlotDirs() const;
 		void setProgress(float progressRead, float progressVerification, Poco::UInt64 blockheight);
-		void setProgress(const std::string& plotDir, float progress, Poco::UInt64 blockheight);
+		/**
+		 * \brief Sets the read progress of a plot directory.
+		 * \param plotDir The path of the plot directory.
+		 * \param progress The progress in percent.
+		 * \param blockheight The block height, the progress belongs to.
+		 * \param bytesRead The amount of bytes, that were read from the directory (only needed when it is done).
+		 * \param seconds The time, the directory was read (only needed when it is done).
+		 * If bytesRead and seconds are given, the throughput of the directory is recorded.
+		 */
+		void setProgress(const std::string& plotDir, float progress, Poco::UInt64 blockheight,
+			Poco::UInt64 bytesRead = 0, double seconds = 0.0);
 		void setBlockTime(Poco::UInt64 bTime);
 
 		Poco::UInt64 getBlockheight() const;
@@ -80,12 +92,34 @@ namespace Burst
 		
 		const GensigData& getGensig() const;
 		const std::string& getGensigStr() const;
+		/**
+		 * \brief Returns the states of the shabal contexts after hashing the gensig of the block.
+		 */
+		std::shared_ptr<const ShabalMidstates> getShabalMidstates() const;
+		/**
+		 * \brief Returns the gensigs of the competing fork tips at the height of the block.
+		 */
+		std::shared_ptr<ForkGensigs> getForkGensigs() const;
+
+		/**
+		 * \brief Calculates the scoop, that is selected by a gensig.
+		 * \param gensig The gensig.
+		 * \param blockHeight The height of the block.
+		 * \return The scoop number.
+		 */
+		static Poco::UInt64 calculateScoop(const GensigData& gensig, Poco::UInt64 blockHeight);
 		std::shared_ptr<Deadline> getBestDeadline() const;
 		std::shared_ptr<Deadline> getBestDeadline(DeadlineSearchType searchType) const;
 		//std::vector<Poco::JSON::Object> getEntries() const;
 		bool forEntries(std::function<bool(const Poco::JSON::Object&)> traverseFunction) const;
 		//const std::unordered_map<AccountId, Deadlines>& getDeadlines() const;
 		std::shared_ptr<Deadline> getBestDeadline(Poco::UInt64 accountId, DeadlineSearchType searchType);
+
+		/**
+		 * \brief Returns true, if a confirmed deadline of this block is below the early exit deadline.
+		 * Then the plot readers skip the rest of the round.
+		 */
+		bool isEarlyExit() const;
 		Poco::ActiveResult<std::shared_ptr<Account>> getLastWinnerAsync(const Wallet& wallet, Accounts& accounts);
 
 		std::shared_ptr<Deadline> addDeadlineIfBest(Poco::UInt64 nonce, Poco::UInt64 deadline,
@@ -128,9 +162,12 @@ namespace Burst
 		std::atomic<Poco::UInt64> scoop_{};
 		std::atomic<Poco::UInt64> baseTarget_;
 		std::atomic<Poco::UInt64> blockTargetDeadline_;
+		std::atomic<bool> earlyExit_{false};
 		GensigData genSig_{};
 		std::string genSigStr_ = "";
-		double roundTime_;
+		std::shared_ptr<const ShabalMidstates> shabalMidstates_;
+		std::shared_ptr<ForkGensigs> forkGensigs_;
+		std::atomic<double> roundTime_{0};
 		Poco::UInt64 blockTime_{};
 		std::shared_ptr<std::vector<Poco::JSON::Object>> entries_;
 		std::shared_ptr<Account> lastWinner_ = nullptr;
@@ -185,6 +222,20 @@ namespace Burst
 
 		void forAllBlocks(Poco::UInt64 from, Poco::UInt64 to, const std::function<bool(std::shared_ptr<BlockData>&)>& traverseFunction) const;
 
+		/**
+		 * \brief Adds a measured read throughput of a plot directory to its moving average.
+		 * \param plotDir The path of the plot directory.
+		 * \param bytesPerSecond The measured throughput.
+		 */
+		void addPlotDirThroughput(const std::string& plotDir, double bytesPerSecond);
+
+		/**
+		 * \brief Returns the moving average of the read throughput of a plot directory.
+		 * \param plotDir The path of the plot directory.
+		 * \return The throughput in bytes per second or 0, if the directory was never read completely.
+		 */
+		double getPlotDirThroughput(const std::string& plotDir) const;
+
 	protected:
 		Poco::UInt64 runGetWonBlocks(const std::pair<const Wallet*, const Accounts*>& args);
 
@@ -192,6 +243,7 @@ namespace Burst
 		Poco::Timestamp startTime_ = {};
 		std::atomic<Poco::UInt64> blocksWon_;
 		std::shared_ptr<BlockData> blockData_ = nullptr;
+		std::unordered_map<std::string, double> plotDirThroughput_;
 		mutable std::mutex mutex_;
 
 		std::unique_ptr<Poco::Data::Session> dbSession_ = nullptr;
@@ -0,0 +1,204 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "Numa.hpp"
+#include "MinerConfig.hpp"
+#include "logging/MinerLogger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <Poco/File.h>
+#endif
+
+namespace Burst
+{
+	namespace NumaHelper
+	{
+		thread_local size_t threadNode = 0;
+
+		/**
+		 * \brief Parses a cpu list of the kernel (e.g. "0-3,8-11").
+		 */
+		std::vector<unsigned> parseCpuList(const std::string& cpuList)
+		{
+			std::vector<unsigned> cpus;
+			std::stringstream stream{cpuList};
+			std::string range;
+
+			while (std::getline(stream, range, ','))
+			{
+				try
+				{
+					const auto dash = range.find('-');
+					const auto first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+					const auto last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+
+					for (auto cpu = first; cpu <= last; ++cpu)
+						cpus.emplace_back(cpu);
+				}
+				catch (...)
+				{
+				}
+			}
+
+			return cpus;
+		}
+	}
+}
+
+Burst::Numa::Numa()
+{
+#ifdef _WIN32
+	ULONG highestNode = 0;
+
+	if (GetNumaHighestNodeNumber(&highestNode))
+	{
+		for (USHORT node = 0; node <= highestNode; ++node)
+		{
+			GROUP_AFFINITY affinity;
+			std::vector<unsigned> cpus;
+
+			if (GetNumaNodeProcessorMaskEx(node, &affinity))
+				for (unsigned bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit)
+					if (affinity.Mask & (static_cast<KAFFINITY>(1) << bit))
+						cpus.emplace_back(affinity.Group * 64 + bit);
+
+			if (!cpus.empty())
+				nodes_.emplace_back(std::move(cpus));
+		}
+	}
+#elif defined(__linux__)
+	for (auto node = 0u; Poco::File{"/sys/devices/system/node/node" + std::to_string(node)}.exists(); ++node)
+	{
+		std::ifstream cpuListFile{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+		std::string cpuList;
+		std::getline(cpuListFile, cpuList);
+
+		auto cpus = NumaHelper::parseCpuList(cpuList);
+
+		// a node without cpus (only memory) can not run a thread
+		if (!cpus.empty())
+			nodes_.emplace_back(std::move(cpus));
+	}
+#endif
+
+	if (nodes_.empty())
+	{
+		std::vector<unsigned> cpus;
+
+		for (auto cpu = 0u; cpu < std::max(std::thread::hardware_concurrency(), 1u); ++cpu)
+			cpus.emplace_back(cpu);
+
+		nodes_.emplace_back(std::move(cpus));
+	}
+}
+
+Burst::Numa& Burst::Numa::instance()
+{
+	static Numa numa;
+	return numa;
+}
+
+size_t Burst::Numa::getNodeCount() const
+{
+	return nodes_.size();
+}
+
+const std::vector<unsigned>& Burst::Numa::getCpus(const size_t node) const
+{
+	return nodes_[node % nodes_.size()];
+}
+
+bool Burst::Numa::pinThread(const size_t node) const
+{
+	if (node >= nodes_.size())
+		return false;
+
+	const auto& cpus = nodes_[node];
+	auto pinned = false;
+
+#ifdef _WIN32
+	GROUP_AFFINITY affinity{};
+	affinity.Group = static_cast<WORD>(cpus.front() / 64);
+
+	for (const auto cpu : cpus)
+		if (cpu / 64 == affinity.Group)
+			affinity.Mask |= static_cast<KAFFINITY>(1) << (cpu % 64);
+
+	pinned = SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+
+	for (const auto cpu : cpus)
+		if (cpu < CPU_SETSIZE)
+			CPU_SET(cpu, &cpuSet);
+
+	pinned = sched_setaffinity(0, sizeof cpuSet, &cpuSet) == 0;
+#endif
+
+	if (pinned)
+		NumaHelper::threadNode = node;
+
+	return pinned;
+}
+
+size_t Burst::Numa::pinThread(const Pool pool)
+{
+	const auto& config = MinerConfig::getConfig();
+
+	if (!config.isNumaAware())
+		return 0;
+
+	auto nodes = pool == Pool::Reader ? config.getNumaReaderNodes() : config.getNumaVerifierNodes();
+
+	// only the existing nodes can be used, no nodes means all nodes
+	nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [this](const size_t node)
+	{
+		return node >= nodes_.size();
+	}), nodes.end());
+
+	if (nodes.empty())
+		for (size_t node = 0; node < nodes_.size(); ++node)
+			nodes.emplace_back(node);
+
+	auto& nextNode = pool == Pool::Reader ? nextReaderNode_ : nextVerifierNode_;
+	const auto node = nodes[nextNode++ % nodes.size()];
+
+	if (pinThread(node))
+		log_debug(MinerLogger::miner, "Pinned a %s to the NUMA node %z", std::string(pool == Pool::Reader ? "plot reader" : "plot verifier"), node);
+	else
+		log_debug(MinerLogger::miner, "Could not pin a %s to the NUMA node %z", std::string(pool == Pool::Reader ? "plot reader" : "plot verifier"), node);
+
+	return getThreadNode();
+}
+
+size_t Burst::Numa::getThreadNode()
+{
+	return NumaHelper::threadNode;
+}
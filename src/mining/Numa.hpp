@@ -0,0 +1,82 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Burst
+{
+	/**
+	 * \brief The NUMA nodes of the system and the cpus, that belong to them.
+	 * The plot readers and verifiers can be pinned to the nodes, so the buffers are allocated
+	 * on the node of the reader and the scoops are verified on the node, where they were read.
+	 * On systems without NUMA (or without support for it) there is only one node with all cpus.
+	 */
+	class Numa
+	{
+	public:
+		enum class Pool
+		{
+			Reader,
+			Verifier
+		};
+
+		static Numa& instance();
+
+		size_t getNodeCount() const;
+
+		/**
+		 * \brief Returns the cpus of a node.
+		 * \param node The index of the node.
+		 */
+		const std::vector<unsigned>& getCpus(size_t node) const;
+
+		/**
+		 * \brief Pins the calling thread to the cpus of a node.
+		 * \param node The index of the node.
+		 * \return true, if the thread is pinned.
+		 */
+		bool pinThread(size_t node) const;
+
+		/**
+		 * \brief Pins the calling thread of a worker pool to the next node of the pool (round robin).
+		 * The nodes of the pools are set in the config, if NUMA awareness is not active, the thread is not pinned.
+		 * \param pool The pool of the calling thread.
+		 * \return The node of the thread.
+		 */
+		size_t pinThread(Pool pool);
+
+		/**
+		 * \brief Returns the node, the calling thread is pinned to (0, if it is not pinned).
+		 */
+		static size_t getThreadNode();
+
+	private:
+		Numa();
+
+		std::vector<std::vector<unsigned>> nodes_;
+		std::atomic<size_t> nextReaderNode_{0};
+		std::atomic<size_t> nextVerifierNode_{0};
+	};
+}
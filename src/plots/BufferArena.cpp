@@ -0,0 +1,257 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "BufferArena.hpp"
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+constexpr Poco::UInt64 Burst::BufferArena::Alignment;
+constexpr Poco::UInt64 Burst::BufferArena::DefaultSlotSize;
+constexpr Poco::UInt64 Burst::BufferArena::MinSlotSize;
+constexpr size_t Burst::BufferArena::AnyNode;
+
+Burst::AlignedBuffer::AlignedBuffer(const Poco::UInt64 size)
+	: data_{nullptr}, size_{size}
+{
+#ifdef _WIN32
+	data_ = static_cast<char*>(_aligned_malloc(static_cast<size_t>(size), BufferArena::Alignment));
+#else
+	void* memory = nullptr;
+
+	if (posix_memalign(&memory, BufferArena::Alignment, static_cast<size_t>(size)) == 0)
+		data_ = static_cast<char*>(memory);
+#endif
+
+	if (data_ == nullptr)
+		throw std::bad_alloc{};
+}
+
+Burst::AlignedBuffer::~AlignedBuffer()
+{
+#ifdef _WIN32
+	_aligned_free(data_);
+#else
+	free(data_);
+#endif
+}
+
+char* Burst::AlignedBuffer::data() const
+{
+	return data_;
+}
+
+Poco::UInt64 Burst::AlignedBuffer::size() const
+{
+	return size_;
+}
+
+bool Burst::BufferSlot::isValid() const
+{
+	return data != nullptr;
+}
+
+void Burst::BufferArena::configure(const Poco::UInt64 maxBufferSize, const Poco::UInt64 chunkCount)
+{
+	auto slotSize = DefaultSlotSize;
+	Poco::UInt64 slotCount = 0;
+
+	if (maxBufferSize > 0)
+	{
+		slotSize = alignUp(std::max(maxBufferSize / std::max(chunkCount, Poco::UInt64{1}), MinSlotSize));
+		slotCount = std::max(maxBufferSize / slotSize, Poco::UInt64{1});
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (slotSize == slotSize_ && slotCount == slotCount_)
+		return;
+
+	auto firstNewSlot = slotCount_;
+
+	if (slotSize != slotSize_)
+	{
+		// the borrowed slots have the old size, they are kept alive until they are given back
+		for (size_t i = 0; i < slots_.size(); ++i)
+			if (used_[i])
+				retired_.emplace(slots_[i]->data(), std::move(slots_[i]));
+
+		slots_.clear();
+		used_.clear();
+		nodes_.clear();
+		free_.clear();
+		allocatedSize_ = 0;
+		slotSize_ = slotSize;
+		firstNewSlot = 0;
+		++generation_;
+	}
+
+	// release the free slots, that are not needed anymore
+	free_.erase(std::remove_if(free_.begin(), free_.end(), [this, slotCount](const size_t index)
+	{
+		if (slotCount == 0 || index < slotCount)
+			return false;
+
+		if (slots_[index] != nullptr)
+			allocatedSize_ -= slots_[index]->size();
+
+		slots_[index].reset();
+		return true;
+	}), free_.end());
+
+	// the new slots are allocated lazily, when they are borrowed for the first time
+	for (auto i = firstNewSlot; i < slotCount; ++i)
+	{
+		if (i >= slots_.size())
+		{
+			slots_.emplace_back(nullptr);
+			used_.emplace_back(false);
+			nodes_.emplace_back(AnyNode);
+		}
+
+		if (!used_[i] && slots_[i] == nullptr)
+			free_.emplace_back(i);
+	}
+
+	slotCount_ = slotCount;
+}
+
+bool Burst::BufferArena::acquire(BufferSlot& slot, const size_t node)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	// more slots are in use than configured (the arena was shrinked or is unlimited), create a new one
+	if (free_.empty())
+	{
+		free_.emplace_back(slots_.size());
+		slots_.emplace_back(nullptr);
+		used_.emplace_back(false);
+		nodes_.emplace_back(AnyNode);
+	}
+
+	auto position = free_.size() - 1;
+
+	// a free slot on the node of the caller first, then a slot, that is not allocated yet (and will be on the node)
+	if (node != AnyNode)
+	{
+		auto iter = std::find_if(free_.rbegin(), free_.rend(), [this, node](const size_t index)
+		{
+			return slots_[index] != nullptr && nodes_[index] == node;
+		});
+
+		if (iter == free_.rend())
+			iter = std::find_if(free_.rbegin(), free_.rend(), [this](const size_t index)
+			{
+				return slots_[index] == nullptr;
+			});
+
+		if (iter != free_.rend())
+			position = free_.size() - 1 - static_cast<size_t>(std::distance(free_.rbegin(), iter));
+	}
+
+	const auto index = free_[position];
+
+	if (slots_[index] == nullptr)
+	{
+		try
+		{
+			slots_[index].reset(new AlignedBuffer(slotSize_));
+			allocatedSize_ += slotSize_;
+			nodes_[index] = node;
+
+			// the pages are placed on the node of the thread, that touches them first
+			if (node != AnyNode)
+				memset(slots_[index]->data(), 0, static_cast<size_t>(slots_[index]->size()));
+		}
+		catch (std::bad_alloc&)
+		{
+			return false;
+		}
+	}
+
+	free_.erase(free_.begin() + position);
+	used_[index] = true;
+
+	slot.data = slots_[index]->data();
+	slot.size = slots_[index]->size();
+	slot.index = index;
+	slot.generation = generation_;
+	slot.node = nodes_[index] == AnyNode ? 0 : nodes_[index];
+	return true;
+}
+
+void Burst::BufferArena::release(BufferSlot& slot)
+{
+	if (!slot.isValid())
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	if (slot.generation != generation_)
+		retired_.erase(slot.data);
+	else
+	{
+		used_[slot.index] = false;
+
+		if (slotCount_ == 0 || slot.index < slotCount_)
+			free_.emplace_back(slot.index);
+		else
+		{
+			allocatedSize_ -= slots_[slot.index]->size();
+			slots_[slot.index].reset();
+		}
+	}
+
+	slot = BufferSlot{};
+}
+
+Poco::UInt64 Burst::BufferArena::getSlotSize() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return slotSize_;
+}
+
+Poco::UInt64 Burst::BufferArena::getSlotCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return slotCount_;
+}
+
+Poco::UInt64 Burst::BufferArena::getAllocatedSize() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return allocatedSize_;
+}
+
+Poco::UInt64 Burst::BufferArena::alignUp(const Poco::UInt64 size)
+{
+	return (size + Alignment - 1) / Alignment * Alignment;
+}
+
+Poco::UInt64 Burst::BufferArena::alignDown(const Poco::UInt64 size)
+{
+	return size / Alignment * Alignment;
+}
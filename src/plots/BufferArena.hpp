@@ -0,0 +1,149 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <limits>
+
+namespace Burst
+{
+	/**
+	 * \brief A block of memory, that is aligned to BufferArena::Alignment.
+	 * The alignment makes it usable as destination for direct (unbuffered) reads.
+	 */
+	class AlignedBuffer
+	{
+	public:
+		explicit AlignedBuffer(Poco::UInt64 size);
+		~AlignedBuffer();
+
+		AlignedBuffer(const AlignedBuffer&) = delete;
+		AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+		char* data() const;
+		Poco::UInt64 size() const;
+
+	private:
+		char* data_;
+		Poco::UInt64 size_;
+	};
+
+	/**
+	 * \brief A handle of a borrowed slot of the buffer arena.
+	 */
+	struct BufferSlot
+	{
+		char* data = nullptr;
+		Poco::UInt64 size = 0;
+		size_t index = 0;
+		Poco::UInt64 generation = 0;
+		size_t node = 0;
+
+		bool isValid() const;
+	};
+
+	/**
+	 * \brief An arena of equally sized, aligned buffers (slots).
+	 * The plot readers borrow the slots and the verifiers give them back, so the memory for the scoops
+	 * is allocated only once (when a slot is used for the first time) and not for every chunk.
+	 * The slots are sized from the maximal buffer size and the buffer chunk count.
+	 */
+	class BufferArena
+	{
+	public:
+		static constexpr Poco::UInt64 Alignment = 4096;
+
+		/**
+		 * \brief The size of one slot, if the buffer size is unlimited.
+		 */
+		static constexpr Poco::UInt64 DefaultSlotSize = 8 * 1024 * 1024;
+
+		/**
+		 * \brief The minimal size of one slot (enough for aligned reads of a scoop and its mirror scoop).
+		 */
+		static constexpr Poco::UInt64 MinSlotSize = 64 * 1024;
+
+		/**
+		 * \brief The node of a slot, that can be used on all NUMA nodes.
+		 */
+		static constexpr size_t AnyNode = std::numeric_limits<size_t>::max();
+
+		/**
+		 * \brief Sets the geometry of the arena.
+		 * If the size of the slots changes, all unused slots are released immediately
+		 * and the borrowed slots are released when they are given back.
+		 * \param maxBufferSize The maximal size of all slots together in bytes. 0 means unlimited.
+		 * \param chunkCount The amount of slots, the buffer size is divided into.
+		 */
+		void configure(Poco::UInt64 maxBufferSize, Poco::UInt64 chunkCount);
+
+		/**
+		 * \brief Borrows a slot. Never blocks.
+		 * If there is no free slot, a new one is created, so the caller needs to limit the slots in use on its own.
+		 * \param slot The handle of the borrowed slot.
+		 * \param node The NUMA node of the caller. A free slot of this node is preferred and a new slot is
+		 * touched by the caller, so its memory is placed on the node (first touch).
+		 * \return true, if a slot was borrowed, false if there is not enough memory.
+		 */
+		bool acquire(BufferSlot& slot, size_t node = AnyNode);
+
+		/**
+		 * \brief Gives a slot back to the arena.
+		 * \param slot The handle of the slot, that is invalid afterwards.
+		 */
+		void release(BufferSlot& slot);
+
+		Poco::UInt64 getSlotSize() const;
+		Poco::UInt64 getSlotCount() const;
+
+		/**
+		 * \brief Returns the amount of memory in bytes, that is currently allocated by the arena.
+		 */
+		Poco::UInt64 getAllocatedSize() const;
+
+		/**
+		 * \brief Rounds a size up to the next multiple of the alignment.
+		 */
+		static Poco::UInt64 alignUp(Poco::UInt64 size);
+
+		/**
+		 * \brief Rounds a size down to the previous multiple of the alignment.
+		 */
+		static Poco::UInt64 alignDown(Poco::UInt64 size);
+
+	private:
+		std::vector<std::unique_ptr<AlignedBuffer>> slots_;
+		std::vector<bool> used_;
+		std::vector<size_t> nodes_;
+		std::vector<size_t> free_;
+		std::map<char*, std::unique_ptr<AlignedBuffer>> retired_;
+		Poco::UInt64 slotSize_ = 0;
+		Poco::UInt64 slotCount_ = 0;
+		Poco::UInt64 generation_ = 0;
+		Poco::UInt64 allocatedSize_ = 0;
+		mutable std::mutex mutex_;
+	};
+}
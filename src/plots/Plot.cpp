@@ -20,6 +20,8 @@
 // ==========================================================================
 
 #include "Plot.hpp"
+#include "PlotConverter.hpp"
+#include "PlotWriter.hpp"
 #include <Poco/SHA1Engine.h>
 #include <Poco/DigestStream.h>
 #include "mining/Miner.hpp"
@@ -28,9 +30,10 @@
 #include "logging/Message.hpp"
 #include "logging/MinerLogger.hpp"
 #include "MinerUtil.hpp"
+#include <algorithm>
 
 Burst::PlotFile::PlotFile(std::string&& path, const Poco::UInt64 size)
-	: path_(move(path)), size_(size)
+	: path_(move(path)), size_(size), convertedPairs_(0), convertedNonces_(0)
 {
 	accountId_ = stoull(getAccountIdFromPlotFile(path_));
 	nonceStart_ = stoull(getStartNonceFromPlotFile(path_));
@@ -52,6 +55,13 @@ Burst::PlotFile::PlotFile(std::string&& path, const Poco::UInt64 size)
 
 	if (!version.empty())
 		version_ = stoull(version);
+
+	// an interrupted conversion into PoC2 is continued later, until then the converted part is read as PoC2
+	Poco::UInt32 pairs;
+	Poco::UInt64 nonces;
+
+	if (version_ == 1 && PlotConverter::readJournal(path_, pairs, nonces))
+		setConversionProgress(pairs, nonces);
 }
 
 const std::string& Burst::PlotFile::getPath() const
@@ -109,6 +119,34 @@ bool Burst::PlotFile::isPoC(int version) const
 	return version_ == version;
 }
 
+Poco::UInt64 Burst::PlotFile::getPoC2Nonces(const Poco::UInt32 scoop) const
+{
+	if (isPoC(2))
+		return getNonces();
+
+	const auto pair = std::min<Poco::UInt32>(scoop, Settings::ScoopPerPlot - 1 - scoop);
+	const auto convertedPairs = convertedPairs_.load();
+
+	if (pair < convertedPairs)
+		return getNonces();
+
+	if (pair == convertedPairs)
+		return convertedNonces_.load();
+
+	return 0;
+}
+
+void Burst::PlotFile::setConversionProgress(const Poco::UInt32 pairs, const Poco::UInt64 nonces)
+{
+	convertedNonces_ = nonces;
+	convertedPairs_ = pairs;
+}
+
+bool Burst::PlotFile::isConverting() const
+{
+	return isPoC(1) && (convertedPairs_ > 0 || convertedNonces_ > 0);
+}
+
 Burst::PlotDir::PlotDir(std::string plotPath, Type type)
 	: path_{std::move(plotPath)},
 	  type_{type},
@@ -116,6 +154,7 @@ Burst::PlotDir::PlotDir(std::string plotPath, Type type)
 {
 	addPlotLocation(path_);
 	recalculateHash();
+	locatePlotfiles();
 }
 
 Burst::PlotDir::PlotDir(std::string path, const std::vector<std::string>& relatedPaths, Type type)
@@ -129,6 +168,7 @@ Burst::PlotDir::PlotDir(std::string path, const std::vector<std::string>& relate
 		relatedDirs_.emplace_back(new PlotDir{relatedPath, type_});
 
 	recalculateHash();
+	locatePlotfiles();
 }
 
 Burst::PlotDir::PlotList Burst::PlotDir::getPlotfiles(bool recursive) const
@@ -176,6 +216,11 @@ const std::string& Burst::PlotDir::getHash() const
 	return hash_;
 }
 
+const std::string& Burst::PlotDir::getDevice() const
+{
+	return device_;
+}
+
 void Burst::PlotDir::rescan()
 {
 	plotfiles_.clear();
@@ -187,6 +232,7 @@ void Burst::PlotDir::rescan()
 		relatedDir->rescan();
 
 	recalculateHash();
+	locatePlotfiles();
 }
 
 bool Burst::PlotDir::addPlotLocation(const std::string& fileOrPath)
@@ -221,7 +267,8 @@ bool Burst::PlotDir::addPlotLocation(const std::string& fileOrPath)
 
 			while (iter != end)
 			{
-				if (iter->isFile())
+				// the journals of the PoC2 conversion and the progress of the plotter lie next to their plot files
+				if (iter->isFile() && !PlotConverter::isJournal(iter->path()) && !PlotWriter::isProgress(iter->path()))
 					addPlotFile(*iter);
 
 				++iter;
@@ -288,3 +335,36 @@ void Burst::PlotDir::recalculateHash()
 	shaStream << std::flush;
 	hash_ = Poco::SHA1Engine::digestToHex(sha.digest());
 }
+
+void Burst::PlotDir::locatePlotfiles()
+{
+	device_ = getDeviceOfPath(path_);
+
+	if (device_.empty())
+		device_ = path_;
+
+	log_debug(MinerLogger::config, "Plot dir %s is stored on device %s", path_, device_);
+
+	std::vector<std::pair<Poco::UInt64, std::shared_ptr<PlotFile>>> offsets, indexes;
+	auto physical = true;
+
+	for (const auto& plotFile : plotfiles_)
+	{
+		Poco::UInt64 offset, index;
+		physical = getPhysicalOffsetOfFile(plotFile->getPath(), offset, index) && physical;
+		offsets.emplace_back(offset, plotFile);
+		indexes.emplace_back(index, plotFile);
+	}
+
+	// if the physical offset of one file is unknown, the file indexes are the better guess
+	if (!physical)
+		offsets = std::move(indexes);
+
+	std::stable_sort(offsets.begin(), offsets.end(), [](const auto& lhs, const auto& rhs)
+	{
+		return lhs.first < rhs.first;
+	});
+
+	for (size_t i = 0; i < offsets.size(); ++i)
+		plotfiles_[i] = offsets[i].second;
+}
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <Poco/Types.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -112,10 +113,32 @@ namespace Burst
 		 */
 		bool isPoC(int version) const;
 
+		/**
+		 * \brief Returns the amount of nonces (from the first one), that are in the PoC2 layout in a scoop.
+		 * A PoC1 plot file, that is converted in place, is PoC2 in the scoops of its converted scoop pairs.
+		 * \param scoop The scoop.
+		 * \return The amount of nonces, all nonces for a PoC2 plot file.
+		 */
+		Poco::UInt64 getPoC2Nonces(Poco::UInt32 scoop) const;
+
+		/**
+		 * \brief Sets the progress of the in place conversion into a PoC2 plot file.
+		 * \param pairs The amount of completely converted scoop pairs (scoop and mirror scoop).
+		 * \param nonces The amount of converted nonces of the next pair.
+		 */
+		void setConversionProgress(Poco::UInt32 pairs, Poco::UInt64 nonces);
+
+		/**
+		 * \brief Returns true, if the PoC1 plot file is partially converted into a PoC2 plot file.
+		 */
+		bool isConverting() const;
+
 	private:
 		std::string path_;
 		Poco::UInt64 size_;
 		Poco::UInt64 accountId_, nonceStart_, nonces_, staggerSize_, version_;
+		std::atomic<Poco::UInt32> convertedPairs_;
+		std::atomic<Poco::UInt64> convertedNonces_;
 	};
 
 	/**
@@ -205,6 +228,13 @@ namespace Burst
 		 */
 		const std::string& getHash() const;
 
+		/**
+		 * \brief Returns the physical device, the plot directory is stored on.
+		 * Plot readers use it to not read from the same disk at the same time.
+		 * \return The name of the device. If unknown, the path of the directory.
+		 */
+		const std::string& getDevice() const;
+
 		/**
 		 * \brief Resets the list of all plot files and searches the directory again for them.
 		 * The unique hash value and the total size is also recalculated.
@@ -235,11 +265,18 @@ namespace Burst
 		 */
 		void recalculateHash();
 
+		/**
+		 * \brief Determines the device of the directory and orders the plot files by their physical position,
+		 * so they can be read without seeking back and forth on the disk.
+		 */
+		void locatePlotfiles();
+
 		std::string path_;
 		Type type_;
 		Poco::UInt64 size_;
 		PlotList plotfiles_;
 		std::vector<std::shared_ptr<PlotDir>> relatedDirs_;
 		std::string hash_;
+		std::string device_;
 	};
 }
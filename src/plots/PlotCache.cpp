@@ -0,0 +1,311 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotCache.hpp"
+#include "Plot.hpp"
+#include "PlotReadBackend.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/DirectoryIterator.h>
+#include <Poco/FileStream.h>
+#include <algorithm>
+#include <vector>
+
+namespace Burst
+{
+	namespace PlotCacheHelper
+	{
+		// the maximal amount of bytes, that is read from the original plot file at once
+		constexpr Poco::UInt64 MaxReadSize = 64 * 1024 * 1024;
+
+		Poco::UInt64 readJournal(const std::string& path)
+		{
+			Poco::UInt64 staggers = 0;
+
+			if (Poco::File{path}.exists())
+			{
+				Poco::FileInputStream stream{path};
+				stream >> staggers;
+
+				if (!stream)
+					staggers = 0;
+			}
+
+			return staggers;
+		}
+
+		void writeJournal(const std::string& path, const Poco::UInt64 staggers)
+		{
+			// the journal is replaced atomically, so a crash leaves either the old or the new one
+			const auto tempPath = path + ".tmp";
+
+			{
+				Poco::FileOutputStream stream{tempPath};
+				stream << staggers;
+			}
+
+			Poco::File{tempPath}.renameTo(path);
+		}
+	}
+}
+
+Burst::PlotCache& Burst::PlotCache::instance()
+{
+	static PlotCache plotCache;
+	return plotCache;
+}
+
+void Burst::PlotCache::setDir(const std::string& dir, const Poco::UInt64 maxSize)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	dir_ = dir;
+	maxSize_ = maxSize;
+	files_.clear();
+
+	if (dir_.empty())
+		return;
+
+	try
+	{
+		Poco::File{dir_}.createDirectories();
+
+		for (Poco::DirectoryIterator iter{dir_}, end; iter != end; ++iter)
+		{
+			// unfinished copies (.tmp) and their journals (.journal) are resumed by the builder
+			if (!iter->isFile() || iter.name().find('.') != std::string::npos ||
+				isValidPlotFile(iter->path()) != PlotCheckResult::Ok)
+				continue;
+
+			auto plotFile = std::make_shared<PlotFile>(std::string(iter->path()), iter->getSize());
+
+			if (!plotFile->isOptimized() || plotFile->getSize() != plotFile->getNonces() * Settings::PlotSize)
+				continue;
+
+			files_.emplace(iter.name(), plotFile);
+		}
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_error(MinerLogger::plotReader, "Could not open the plot cache %s", dir_);
+		log_exception(MinerLogger::plotReader, exc);
+	}
+
+	log_information(MinerLogger::plotReader, "Plot cache %s holds %z plot files", dir_, files_.size());
+}
+
+bool Burst::PlotCache::isActive() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	return !dir_.empty();
+}
+
+std::shared_ptr<Burst::PlotFile> Burst::PlotCache::getCachedFile(const PlotFile& plotFile) const
+{
+	if (!isCacheable(plotFile))
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock{mutex_};
+	const auto iter = files_.find(getFileName(plotFile));
+
+	if (iter == files_.end())
+		return nullptr;
+
+	return iter->second;
+}
+
+void Burst::PlotCache::build(const std::function<bool()>& cancelled)
+{
+	std::string dir;
+	Poco::UInt64 maxSize, usedSize = 0;
+	std::vector<std::shared_ptr<PlotFile>> candidates;
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+
+		if (dir_.empty())
+			return;
+
+		dir = dir_;
+		maxSize = maxSize_;
+
+		for (const auto& file : files_)
+			usedSize += file.second->getSize();
+
+		for (const auto& plotFile : MinerConfig::getConfig().getPlotFiles())
+			if (isCacheable(*plotFile) && files_.find(getFileName(*plotFile)) == files_.end())
+				candidates.emplace_back(plotFile);
+	}
+
+	for (const auto& plotFile : candidates)
+	{
+		if (cancelled())
+			return;
+
+		const auto size = plotFile->getSize();
+
+		if (maxSize > 0 && usedSize + size > maxSize)
+			continue;
+
+		try
+		{
+			// a partially built copy already occupies its space
+			const Poco::File tempFile{Poco::Path{dir, getFileName(*plotFile) + ".tmp"}};
+			const auto reservedSize = tempFile.exists() ? tempFile.getSize() : 0;
+
+			if (Poco::File{dir}.usableSpace() + reservedSize < size)
+			{
+				log_debug(MinerLogger::plotReader, "Not enough space in the plot cache for %s", plotFile->getPath());
+				continue;
+			}
+
+			if (buildFile(*plotFile, cancelled))
+				usedSize += size;
+		}
+		catch (Poco::Exception& exc)
+		{
+			log_error(MinerLogger::plotReader, "Could not cache the plot file %s", plotFile->getPath());
+			log_exception(MinerLogger::plotReader, exc);
+		}
+	}
+}
+
+bool Burst::PlotCache::isCacheable(const PlotFile& plotFile)
+{
+	// a partially converted plot file is neither PoC1 nor PoC2
+	return plotFile.isPoC(1) && !plotFile.isOptimized() && !plotFile.isConverting();
+}
+
+bool Burst::PlotCache::buildFile(const PlotFile& plotFile, const std::function<bool()>& cancelled)
+{
+	std::string dir;
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		dir = dir_;
+	}
+
+	const auto path = Poco::Path{dir, getFileName(plotFile)}.toString();
+	const auto tempPath = path + ".tmp";
+	const auto journalPath = path + ".journal";
+
+	const auto nonces = plotFile.getNonces();
+	const auto staggerScoopBytes = plotFile.getStaggerScoopBytes();
+	const auto size = nonces * Settings::PlotSize;
+
+	// the journal holds the amount of staggers, that are completely written into the copy
+	auto stagger = PlotCacheHelper::readJournal(journalPath);
+
+	{
+		PlotFileHandle source{plotFile.getPath()};
+		PlotFileHandle target{tempPath, false, true};
+
+		if (!source.isOpen() || !target.isOpen() || (stagger == 0 && !target.resize(size)))
+		{
+			log_error(MinerLogger::plotReader, "Could not create the cache file %s", tempPath);
+			return false;
+		}
+
+		if (stagger > 0)
+			log_debug(MinerLogger::plotReader, "Resuming the cache file %s at stagger %Lu", tempPath, stagger);
+		else
+			log_debug(MinerLogger::plotReader, "Building the cache file %s", tempPath);
+
+		// one read holds one or more scoops of a stagger, every scoop is written to its own block in the copy
+		const auto scoopsPerRead = std::min<Poco::UInt64>(std::max<Poco::UInt64>(PlotCacheHelper::MaxReadSize / staggerScoopBytes, 1),
+			Settings::ScoopPerPlot);
+		std::vector<char> buffer(scoopsPerRead * staggerScoopBytes);
+
+		for (; stagger < plotFile.getStaggerCount(); ++stagger)
+		{
+			for (Poco::UInt64 scoop = 0; scoop < Settings::ScoopPerPlot; scoop += scoopsPerRead)
+			{
+				if (cancelled())
+					return false;
+
+				const auto scoops = std::min<Poco::UInt64>(scoopsPerRead, Settings::ScoopPerPlot - scoop);
+				const auto bytes = static_cast<Poco::Int64>(scoops * staggerScoopBytes);
+
+				if (source.read(buffer.data(), bytes, stagger * plotFile.getStaggerBytes() + scoop * staggerScoopBytes) != bytes)
+				{
+					log_error(MinerLogger::plotReader, "Could not read the plot file %s for the plot cache", plotFile.getPath());
+					return false;
+				}
+
+				for (Poco::UInt64 i = 0; i < scoops; ++i)
+				{
+					const auto offset = (scoop + i) * nonces * Settings::ScoopSize + stagger * staggerScoopBytes;
+
+					if (target.write(buffer.data() + i * staggerScoopBytes, staggerScoopBytes, offset) !=
+						static_cast<Poco::Int64>(staggerScoopBytes))
+					{
+						log_error(MinerLogger::plotReader, "Could not write the cache file %s", tempPath);
+						return false;
+					}
+				}
+			}
+
+			// the journal must never be ahead of the data on the disk
+			if (!target.sync())
+			{
+				log_error(MinerLogger::plotReader, "Could not write the cache file %s", tempPath);
+				return false;
+			}
+
+			PlotCacheHelper::writeJournal(journalPath, stagger + 1);
+		}
+	}
+
+	Poco::File{tempPath}.renameTo(path);
+	Poco::File{journalPath}.remove();
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		files_[getFileName(plotFile)] = std::make_shared<PlotFile>(std::string(path), size);
+	}
+
+	log_information(MinerLogger::plotReader, "Cached the plot file %s as %s", plotFile.getPath(), path);
+	return true;
+}
+
+std::string Burst::PlotCache::getFileName(const PlotFile& plotFile) const
+{
+	// the stagger size equals the nonces, so the copy is an optimized PoC1 plot file
+	return std::to_string(plotFile.getAccountId()) + "_" + std::to_string(plotFile.getNonceStart()) + "_" +
+		std::to_string(plotFile.getNonces()) + "_" + std::to_string(plotFile.getNonces());
+}
+
+Burst::PlotCacheBuilder::PlotCacheBuilder()
+	: Task("PlotCacheBuilder")
+{
+}
+
+void Burst::PlotCacheBuilder::runTask()
+{
+	PlotCache::instance().build([this]()
+	{
+		return isCancelled();
+	});
+}
@@ -0,0 +1,101 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Task.h>
+#include <Poco/Types.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Burst
+{
+	class PlotFile;
+
+	/**
+	 * \brief A cache of unoptimized plot files on a fast disk (SSD).
+	 * An unoptimized plot file scatters one scoop over all of its staggers, so a round needs one seek per stagger.
+	 * The cache holds a scoop-major (optimized) copy of such a file, where every scoop is one contiguous block.
+	 * A cached copy is a valid optimized plot file named <account>_<start>_<nonces>_<nonces>, it is
+	 * only read instead of the original and never counted as an own plot file.
+	 * The copies are built between the rounds by the PlotCacheBuilder.
+	 */
+	class PlotCache
+	{
+	public:
+		static PlotCache& instance();
+
+		/**
+		 * \brief Sets the directory of the cache and registers all completed cache files inside it.
+		 * \param dir The directory of the cache, an empty string deactivates the cache.
+		 * \param maxSize The maximal size of all cache files in bytes, 0 means no limit (besides the free disk space).
+		 */
+		void setDir(const std::string& dir, Poco::UInt64 maxSize);
+
+		/**
+		 * \brief Returns true, if a cache directory is set.
+		 */
+		bool isActive() const;
+
+		/**
+		 * \brief Returns the cached copy of a plot file.
+		 * \param plotFile The original plot file.
+		 * \return The completed copy or nullptr, if the plot file is not cached.
+		 */
+		std::shared_ptr<PlotFile> getCachedFile(const PlotFile& plotFile) const;
+
+		/**
+		 * \brief Builds the copies of all plot files, that are not cached yet and fit into the cache.
+		 * An interrupted build is resumed at the last completed stagger.
+		 * \param cancelled Is called after every chunk, if it returns true the build is stopped.
+		 */
+		void build(const std::function<bool()>& cancelled);
+
+		/**
+		 * \brief Returns true, if the plot file can be cached (an unoptimized PoC1 plot file).
+		 */
+		static bool isCacheable(const PlotFile& plotFile);
+
+	private:
+		PlotCache() = default;
+
+		bool buildFile(const PlotFile& plotFile, const std::function<bool()>& cancelled);
+		std::string getFileName(const PlotFile& plotFile) const;
+
+		mutable std::mutex mutex_;
+		std::string dir_;
+		Poco::UInt64 maxSize_ = 0;
+		std::unordered_map<std::string, std::shared_ptr<PlotFile>> files_;
+	};
+
+	/**
+	 * \brief Builds the plot cache in the background, until it is cancelled.
+	 */
+	class PlotCacheBuilder : public Poco::Task
+	{
+	public:
+		PlotCacheBuilder();
+		void runTask() override;
+	};
+}
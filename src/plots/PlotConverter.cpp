@@ -0,0 +1,473 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotConverter.hpp"
+#include "Plot.hpp"
+#include "PlotCache.hpp"
+#include "PlotReadBackend.hpp"
+#include "Declarations.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include "mining/MinerConfig.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <Poco/String.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+constexpr Poco::UInt32 Burst::PlotConverter::ScoopPairs;
+
+namespace Burst
+{
+	namespace PlotConverterHelper
+	{
+		/**
+		 * \brief The head of the redo file, the swapped block follows at RedoDataOffset.
+		 */
+		struct RedoHeader
+		{
+			Poco::UInt64 pairs = 0;
+			Poco::UInt64 startNonce = 0;
+			Poco::UInt64 nonces = 0;
+		};
+
+		const Poco::UInt64 RedoDataOffset = 64;
+
+		std::string getJournalPath(const std::string& path)
+		{
+			return path + ".convert";
+		}
+
+		std::string getRedoPath(const std::string& path)
+		{
+			return path + ".redo";
+		}
+
+		bool writeJournal(const std::string& path, const Poco::UInt32 pairs, const Poco::UInt64 nonces)
+		{
+			// the journal is replaced atomically and is on the disk before, so a crash leaves either the old or the new one
+			const auto journalPath = getJournalPath(path);
+			const auto tempPath = journalPath + ".tmp";
+			const auto content = std::to_string(pairs) + " " + std::to_string(nonces);
+
+			{
+				PlotFileHandle journal{tempPath, false, true};
+
+				if (!journal.isOpen() || !journal.resize(0) ||
+					journal.write(content.data(), content.size(), 0) != static_cast<Poco::Int64>(content.size()) ||
+					!journal.sync())
+					return false;
+			}
+
+			try
+			{
+				Poco::File{tempPath}.renameTo(journalPath);
+				return true;
+			}
+			catch (Poco::Exception&)
+			{
+				return false;
+			}
+		}
+
+		/**
+		 * \brief Swaps the second hashes of the scoops and the mirror scoops of a block.
+		 * \param buffer The block, first the scoops of all nonces, then their mirror scoops.
+		 * \param nonces The amount of nonces.
+		 */
+		void swapHashes(char* buffer, const Poco::UInt64 nonces)
+		{
+			const auto mirrors = buffer + nonces * Settings::ScoopSize;
+
+			for (Poco::UInt64 i = 0; i < nonces; ++i)
+			{
+				const auto scoop = buffer + i * Settings::ScoopSize + Settings::HashSize;
+				std::swap_ranges(scoop, scoop + Settings::HashSize, mirrors + i * Settings::ScoopSize + Settings::HashSize);
+			}
+		}
+	}
+}
+
+void Burst::PlotConverter::setMaxMemory(const Poco::UInt64 maxMemory)
+{
+	maxMemory_ = maxMemory;
+}
+
+void Burst::PlotConverter::setMaxSpeed(const Poco::UInt64 bytesPerSecond)
+{
+	maxSpeed_ = bytesPerSecond;
+}
+
+bool Burst::PlotConverter::convert(PlotFile& plotFile, const std::function<bool()>& cancelled) const
+{
+	using namespace PlotConverterHelper;
+
+	if (!plotFile.isPoC(1))
+		return false;
+
+	const auto& path = plotFile.getPath();
+	const auto nonces = plotFile.getNonces();
+	Poco::UInt32 pairs = 0;
+	Poco::UInt64 converted = 0;
+
+	// a damaged journal can not be resumed, a new start would swap the converted pairs back
+	if (!readJournal(path, pairs, converted) && Poco::File{getJournalPath(path)}.exists())
+	{
+		log_error(MinerLogger::plotReader, "The conversion journal of the plot file %s is damaged", path);
+		return false;
+	}
+
+	{
+		const PlotFileHandle file{path, false, true};
+		const PlotFileHandle redoFile{getRedoPath(path), false, true};
+
+		if (!file.isOpen() || !redoFile.isOpen())
+		{
+			log_error(MinerLogger::plotReader, "Could not open the plot file %s for the PoC2 conversion", path);
+			return false;
+		}
+
+		const auto blockNonces = std::min(std::max<Poco::UInt64>(maxMemory_ / (2 * Settings::ScoopSize), 1), nonces);
+		std::vector<char> buffer(2 * blockNonces * Settings::ScoopSize);
+
+		if (!redo(plotFile, file, redoFile, pairs, converted, buffer))
+			return false;
+
+		if (pairs > 0 || converted > 0)
+			log_information(MinerLogger::plotReader, "Resuming the PoC2 conversion of %s at scoop pair %u/%u",
+				path, pairs, ScoopPairs);
+		else
+			log_information(MinerLogger::plotReader, "Converting the plot file %s into PoC2", path);
+
+		const auto stop = [&]()
+		{
+			log_debug(MinerLogger::plotReader, "Stopped the PoC2 conversion of %s at scoop pair %u/%u", path, pairs, ScoopPairs);
+			return false;
+		};
+
+		for (; pairs < ScoopPairs; ++pairs, converted = 0)
+		{
+			while (converted < nonces)
+			{
+				if (cancelled())
+					return stop();
+
+				const auto startPoint = std::chrono::steady_clock::now();
+				const auto startNonce = converted;
+				const auto blockSize = std::min(blockNonces, nonces - startNonce);
+				const auto bytes = 2 * blockSize * Settings::ScoopSize;
+
+				if (!transfer(plotFile, file, pairs, startNonce, blockSize, buffer.data(), false, cancelled))
+				{
+					if (cancelled())
+						return stop();
+
+					log_error(MinerLogger::plotReader, "Could not read the plot file %s for the PoC2 conversion", path);
+					return false;
+				}
+
+				swapHashes(buffer.data(), blockSize);
+
+				// the redo file needs to be complete on the disk, before the plot file is touched
+				RedoHeader header;
+				header.pairs = pairs;
+				header.startNonce = startNonce;
+				header.nonces = blockSize;
+
+				if (redoFile.write(buffer.data(), bytes, RedoDataOffset) != static_cast<Poco::Int64>(bytes) || !redoFile.sync() ||
+					redoFile.write(&header, sizeof header, 0) != static_cast<Poco::Int64>(sizeof header) || !redoFile.sync())
+				{
+					log_error(MinerLogger::plotReader, "Could not write the redo file of %s", path);
+					return false;
+				}
+
+				// the swapped block, its sync and the journal are always finished, even when a new round starts,
+				// otherwise the readers would take the half swapped nonces for PoC1 nonces
+				if (!transfer(plotFile, file, pairs, startNonce, blockSize, buffer.data(), true, cancelled) || !file.sync())
+				{
+					log_error(MinerLogger::plotReader, "Could not write the plot file %s for the PoC2 conversion", path);
+					return false;
+				}
+
+				converted += blockSize;
+
+				// the journal must never be ahead of the data on the disk
+				const auto completedPairs = converted == nonces ? pairs + 1 : pairs;
+				const auto completedNonces = converted == nonces ? 0 : converted;
+
+				if (!writeJournal(path, completedPairs, completedNonces))
+				{
+					log_error(MinerLogger::plotReader, "Could not write the conversion journal of %s", path);
+					return false;
+				}
+
+				plotFile.setConversionProgress(completedPairs, completedNonces);
+
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startPoint;
+				throttle(3 * bytes, elapsed.count(), cancelled);
+			}
+
+			if ((pairs + 1) % (ScoopPairs / 16) == 0)
+				log_information(MinerLogger::plotReader, "Converted %u/%u scoop pairs of %s", pairs + 1, ScoopPairs, path);
+		}
+	}
+
+	return finish(plotFile);
+}
+
+size_t Burst::PlotConverter::convertAll(const std::function<bool()>& cancelled) const
+{
+	std::vector<std::shared_ptr<PlotFile>> candidates;
+
+	for (const auto& plotFile : MinerConfig::getConfig().getPlotFiles())
+	{
+		if (!plotFile->isPoC(1))
+			continue;
+
+		// the unoptimized plot files are read from their cached copies, the original plot files need to stay PoC1
+		if (!plotFile->isConverting() && PlotCache::instance().isActive() && PlotCache::isCacheable(*plotFile))
+			continue;
+
+		candidates.emplace_back(plotFile);
+	}
+
+	// the partially converted plot files are finished first
+	std::stable_partition(candidates.begin(), candidates.end(), [](const std::shared_ptr<PlotFile>& plotFile)
+	{
+		return plotFile->isConverting();
+	});
+
+	size_t convertedFiles = 0;
+
+	for (const auto& plotFile : candidates)
+	{
+		if (cancelled())
+			break;
+
+		try
+		{
+			if (convert(*plotFile, cancelled))
+				++convertedFiles;
+		}
+		catch (Poco::Exception& exc)
+		{
+			log_error(MinerLogger::plotReader, "Could not convert the plot file %s into PoC2", plotFile->getPath());
+			log_exception(MinerLogger::plotReader, exc);
+		}
+	}
+
+	return convertedFiles;
+}
+
+bool Burst::PlotConverter::readJournal(const std::string& path, Poco::UInt32& pairs, Poco::UInt64& nonces)
+{
+	const auto journalPath = PlotConverterHelper::getJournalPath(path);
+	const PlotFileHandle journal{journalPath};
+
+	if (!journal.isOpen())
+		return false;
+
+	std::string content(64, '\0');
+	const auto size = journal.read(&content[0], content.size(), 0);
+
+	if (size <= 0)
+		return false;
+
+	content.resize(static_cast<size_t>(size));
+	std::istringstream stream{content};
+	Poco::UInt64 readPairs, readNonces;
+
+	if (!(stream >> readPairs >> readNonces) || readPairs > ScoopPairs)
+		return false;
+
+	pairs = static_cast<Poco::UInt32>(readPairs);
+	nonces = readNonces;
+	return true;
+}
+
+bool Burst::PlotConverter::isJournal(const std::string& path)
+{
+	const auto endsWith = [&path](const std::string& suffix)
+	{
+		return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+	};
+
+	return endsWith(".convert") || endsWith(".convert.tmp") || endsWith(".redo");
+}
+
+std::string Burst::PlotConverter::getPoC2Path(const PlotFile& plotFile)
+{
+	auto name = std::to_string(plotFile.getAccountId()) + "_" + std::to_string(plotFile.getNonceStart()) + "_" +
+		std::to_string(plotFile.getNonces());
+
+	if (plotFile.getStaggerSize() != plotFile.getNonces())
+		name += "_" + std::to_string(plotFile.getStaggerSize()) + "_2";
+
+	Poco::Path path{plotFile.getPath()};
+	path.setFileName(name);
+	return path.toString();
+}
+
+bool Burst::PlotConverter::redo(PlotFile& plotFile, const PlotFileHandle& file, const PlotFileHandle& redoFile,
+	Poco::UInt32& pairs, Poco::UInt64& nonces, std::vector<char>& buffer) const
+{
+	using namespace PlotConverterHelper;
+
+	// only the block right after the journal can be half written, all older redo blocks are on the disk already
+	RedoHeader header;
+
+	if (redoFile.read(&header, sizeof header, 0) != static_cast<Poco::Int64>(sizeof header) ||
+		header.pairs != pairs || header.startNonce != nonces || header.nonces == 0 ||
+		header.nonces > plotFile.getNonces() - nonces)
+		return true;
+
+	const auto bytes = 2 * header.nonces * Settings::ScoopSize;
+
+	if (buffer.size() < bytes)
+		buffer.resize(bytes);
+
+	if (redoFile.read(buffer.data(), bytes, RedoDataOffset) != static_cast<Poco::Int64>(bytes) ||
+		!transfer(plotFile, file, pairs, nonces, header.nonces, buffer.data(), true, []() { return false; }) || !file.sync())
+	{
+		log_error(MinerLogger::plotReader, "Could not repair the interrupted PoC2 conversion of %s", plotFile.getPath());
+		return false;
+	}
+
+	nonces += header.nonces;
+
+	if (nonces == plotFile.getNonces())
+	{
+		++pairs;
+		nonces = 0;
+	}
+
+	if (!writeJournal(plotFile.getPath(), pairs, nonces))
+	{
+		log_error(MinerLogger::plotReader, "Could not write the conversion journal of %s", plotFile.getPath());
+		return false;
+	}
+
+	plotFile.setConversionProgress(pairs, nonces);
+	log_information(MinerLogger::plotReader, "Repaired the interrupted PoC2 conversion of %s", plotFile.getPath());
+	return true;
+}
+
+bool Burst::PlotConverter::finish(PlotFile& plotFile) const
+{
+	using namespace PlotConverterHelper;
+
+	const auto& path = plotFile.getPath();
+	const auto poc2Path = getPoC2Path(plotFile);
+
+	// the plot file is renamed first, without its journal the PoC1 name would be read as an unconverted file
+	if (Poco::File{poc2Path}.exists())
+	{
+		log_error(MinerLogger::plotReader, "Could not rename the converted plot file %s, %s already exists", path, poc2Path);
+		return false;
+	}
+
+	Poco::File{path}.renameTo(poc2Path);
+	plotFile.setConversionProgress(ScoopPairs, 0);
+
+	for (const auto& sideFile : {getJournalPath(path), getRedoPath(path)})
+	{
+		try
+		{
+			Poco::File{sideFile}.remove();
+		}
+		catch (Poco::Exception& exc)
+		{
+			log_debug(MinerLogger::plotReader, "Could not remove %s: %s", sideFile, exc.displayText());
+		}
+	}
+
+	log_success(MinerLogger::plotReader, "Converted the plot file %s into PoC2 (%s)", path, poc2Path);
+	return true;
+}
+
+void Burst::PlotConverter::throttle(const Poco::UInt64 bytes, const double seconds, const std::function<bool()>& cancelled) const
+{
+	if (maxSpeed_ == 0)
+		return;
+
+	// sleep in small steps, so a new round does not need to wait for the conversion
+	auto rest = static_cast<double>(bytes) / maxSpeed_ - seconds;
+
+	while (rest > 0 && !cancelled())
+	{
+		const auto step = std::min(rest, 0.1);
+		std::this_thread::sleep_for(std::chrono::duration<double>{step});
+		rest -= step;
+	}
+}
+
+bool Burst::PlotConverter::transfer(const PlotFile& plotFile, const PlotFileHandle& file, const Poco::UInt32 pair,
+	const Poco::UInt64 startNonce, const Poco::UInt64 nonces, char* buffer, const bool write,
+	const std::function<bool()>& cancelled)
+{
+	const auto staggerSize = plotFile.getStaggerSize();
+	const auto endNonce = startNonce + nonces;
+	const Poco::UInt64 scoops[] = {pair, Settings::ScoopPerPlot - 1 - pair};
+
+	// the scoops of all nonces fill the first half of the buffer, the mirror scoops the second half
+	for (size_t i = 0; i < 2; ++i)
+	{
+		for (auto nonce = startNonce; nonce < endNonce;)
+		{
+			// only the reading can be stopped, an unoptimized plot file has many small stagger runs to read
+			if (!write && cancelled())
+				return false;
+
+			const auto staggerNonce = nonce % staggerSize;
+			const auto blockNonces = std::min(staggerSize - staggerNonce, endNonce - nonce);
+			const auto offset = nonce / staggerSize * plotFile.getStaggerBytes() + scoops[i] * plotFile.getStaggerScoopBytes() +
+				staggerNonce * Settings::ScoopSize;
+			const auto size = blockNonces * Settings::ScoopSize;
+			const auto data = buffer + (i * nonces + nonce - startNonce) * Settings::ScoopSize;
+			const auto result = write ? file.write(data, size, offset) : file.read(data, size, offset);
+
+			if (result != static_cast<Poco::Int64>(size))
+				return false;
+
+			nonce += blockNonces;
+		}
+	}
+
+	return true;
+}
+
+Burst::PlotConverterTask::PlotConverterTask()
+	: Task("PlotConverterTask")
+{
+}
+
+void Burst::PlotConverterTask::runTask()
+{
+	PlotConverter converter;
+	converter.setMaxMemory(MaxMemory);
+	converter.setMaxSpeed(MinerConfig::getConfig().getPoC2ConversionMaxSpeed());
+
+	// the converted plot files have new names, they are found by a rescan before the next round
+	if (converter.convertAll([this]() { return isCancelled(); }) > 0)
+		MinerConfig::getConfig().rescanPlotfiles();
+}
@@ -0,0 +1,130 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Task.h>
+#include <Poco/Types.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Burst
+{
+	class PlotFile;
+	class PlotFileHandle;
+
+	/**
+	 * \brief Converts PoC1 plot files in place into PoC2 plot files.
+	 * A PoC2 scoop holds the second hash of its mirror scoop (4095 - scoop), so the conversion swaps the second hashes
+	 * of every scoop pair. The pairs are converted one after another and every pair from the first to the last nonce,
+	 * so a plot file can be mined in the middle of its conversion (see PlotFile::getPoC2Nonces).
+	 * The progress is journaled in <plotfile>.convert and every swapped block is written into <plotfile>.redo,
+	 * before it is written into the plot file, so an interrupted conversion never leaves a half swapped block.
+	 * A completed plot file is renamed to its PoC2 name.
+	 */
+	class PlotConverter
+	{
+	public:
+		/**
+		 * \brief Sets the memory of one swapped block (scoops and mirror scoops).
+		 * \param maxMemory The memory in bytes.
+		 */
+		void setMaxMemory(Poco::UInt64 maxMemory);
+
+		/**
+		 * \brief Sets the maximal speed of the conversion (reads and writes).
+		 * \param bytesPerSecond The speed in bytes per second, 0 means no limit.
+		 */
+		void setMaxSpeed(Poco::UInt64 bytesPerSecond);
+
+		/**
+		 * \brief Converts a plot file or continues its interrupted conversion.
+		 * \param plotFile The PoC1 plot file, its progress is updated after every block.
+		 * \param cancelled Is called before every block and while a block is read, if it returns true the conversion is stopped.
+		 * A block, that is already swapped, is always written completely.
+		 * \return true, if the plot file is completely converted and renamed.
+		 */
+		bool convert(PlotFile& plotFile, const std::function<bool()>& cancelled) const;
+
+		/**
+		 * \brief Converts all PoC1 plot files of the miner, the partially converted ones first.
+		 * Unoptimized plot files, that are served by the plot cache, are not converted.
+		 * \param cancelled Is called before every block and while a block is read, if it returns true the conversion is stopped.
+		 * \return The amount of completely converted plot files.
+		 */
+		size_t convertAll(const std::function<bool()>& cancelled) const;
+
+		/**
+		 * \brief Reads the progress of an interrupted conversion.
+		 * \param path The path of the plot file.
+		 * \param pairs The amount of completely converted scoop pairs.
+		 * \param nonces The amount of converted nonces of the next pair.
+		 * \return true, if the plot file has a journal.
+		 */
+		static bool readJournal(const std::string& path, Poco::UInt32& pairs, Poco::UInt64& nonces);
+
+		/**
+		 * \brief Returns true, if the file is a journal of a conversion and not a plot file.
+		 */
+		static bool isJournal(const std::string& path);
+
+		/**
+		 * \brief Returns the path of the plot file after the conversion.
+		 * An optimized plot file is named <account>_<start>_<nonces>,
+		 * an unoptimized one keeps its stagger size and gets the version: <account>_<start>_<nonces>_<stagger>_2.
+		 */
+		static std::string getPoC2Path(const PlotFile& plotFile);
+
+		/**
+		 * \brief The amount of scoop pairs of a nonce.
+		 */
+		static constexpr Poco::UInt32 ScoopPairs = 2048;
+
+	private:
+		bool redo(PlotFile& plotFile, const PlotFileHandle& file, const PlotFileHandle& redoFile, Poco::UInt32& pairs,
+			Poco::UInt64& nonces, std::vector<char>& buffer) const;
+		bool finish(PlotFile& plotFile) const;
+		void throttle(Poco::UInt64 bytes, double seconds, const std::function<bool()>& cancelled) const;
+
+		static bool transfer(const PlotFile& plotFile, const PlotFileHandle& file, Poco::UInt32 pair, Poco::UInt64 startNonce,
+			Poco::UInt64 nonces, char* buffer, bool write, const std::function<bool()>& cancelled);
+
+		Poco::UInt64 maxMemory_ = 64 * 1024 * 1024;
+		Poco::UInt64 maxSpeed_ = 0;
+	};
+
+	/**
+	 * \brief Converts the PoC1 plot files of the miner in the background, until it is cancelled.
+	 */
+	class PlotConverterTask : public Poco::Task
+	{
+	public:
+		PlotConverterTask();
+		void runTask() override;
+
+		/**
+		 * \brief The memory of one swapped block in the miner.
+		 * The block is small, so a new round does not wait long for the write and the syncs of the current block.
+		 */
+		static constexpr Poco::UInt64 MaxMemory = 4 * 1024 * 1024;
+	};
+}
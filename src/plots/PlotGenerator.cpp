@@ -226,6 +226,34 @@ std::array<std::vector<char>, Burst::Shabal256_AVX2::HashSize> Burst::PlotGenera
 	return generate<Shabal256_AVX2, PlotGeneratorOperations8<Shabal256_AVX2>>(account, startNonce);
 }
 
+std::array<std::vector<char>, Burst::Shabal256_AVX512::HashSize> Burst::PlotGenerator::generateAvx512(const Poco::UInt64 account, const Poco::UInt64 startNonce)
+{
+	return generate<Shabal256_AVX512, PlotGeneratorOperations16<Shabal256_AVX512>>(account, startNonce);
+}
+
+std::vector<std::vector<char>> Burst::PlotGenerator::generateNonces(const std::string& instructionSet,
+	const Poco::UInt64 account, const Poco::UInt64 startNonce)
+{
+	const auto toVector = [](auto&& gendatas)
+	{
+		return std::vector<std::vector<char>>{std::make_move_iterator(gendatas.begin()), std::make_move_iterator(gendatas.end())};
+	};
+
+	if (instructionSet == "SSE4" && Settings::Sse4)
+		return toVector(generateSse4(account, startNonce));
+
+	if (instructionSet == "AVX" && Settings::Avx)
+		return toVector(generateAvx(account, startNonce));
+
+	if (instructionSet == "AVX2" && Settings::Avx2)
+		return toVector(generateAvx2(account, startNonce));
+
+	if (instructionSet == "AVX512F" && Settings::Avx512)
+		return toVector(generateAvx512(account, startNonce));
+
+	return {generateSse2(account, startNonce)};
+}
+
 Poco::UInt64 Burst::PlotGenerator::calculateDeadlineSse2(std::vector<char>& gendata,
 	GensigData& generationSignature, const Poco::UInt64 scoop, const Poco::UInt64 baseTarget)
 {
@@ -254,10 +282,17 @@ std::array<Poco::UInt64, Burst::Shabal256_AVX2::HashSize> Burst::PlotGenerator::
 	return calculateDeadline<Shabal256_AVX2, PlotGeneratorOperations8<Shabal256_AVX2>>(gendatas, generationSignature, scoop, baseTarget);
 }
 
+std::array<Poco::UInt64, Burst::Shabal256_AVX512::HashSize> Burst::PlotGenerator::
+	calculateDeadlineAvx512(std::array<std::vector<char>, Shabal256_AVX512::HashSize>& gendatas,
+		GensigData& generationSignature, const Poco::UInt64 scoop, const Poco::UInt64 baseTarget)
+{
+	return calculateDeadline<Shabal256_AVX512, PlotGeneratorOperations16<Shabal256_AVX512>>(gendatas, generationSignature, scoop, baseTarget);
+}
+
 void Burst::PlotGenerator::convertToPoC2(char* gendata)
 {
 	std::array<char, Settings::HashSize> buffer{};
-	auto indexMirror = Settings::HashSize - Settings::ScoopSize;
+	auto indexMirror = Settings::PlotSize - Settings::ScoopSize;
 
 	for (size_t i = 0; i < Settings::PlotSize / 2; i += Settings::ScoopSize)
 	{
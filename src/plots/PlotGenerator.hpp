@@ -46,6 +46,17 @@ namespace Burst
 		static std::array<std::vector<char>, Shabal256_AVX::HashSize> generateAvx(Poco::UInt64 account, Poco::UInt64 startNonce);
 		static std::array<std::vector<char>, Shabal256_SSE4::HashSize> generateSse4(Poco::UInt64 account, Poco::UInt64 startNonce);
 		static std::array<std::vector<char>, Shabal256_AVX2::HashSize> generateAvx2(Poco::UInt64 account, Poco::UInt64 startNonce);
+		static std::array<std::vector<char>, Shabal256_AVX512::HashSize> generateAvx512(Poco::UInt64 account, Poco::UInt64 startNonce);
+
+		/**
+		 * \brief Generates consecutive nonces with the kernel of an instruction set.
+		 * \param instructionSet The instruction set (SSE2, SSE4, AVX, AVX2, AVX512F), that needs to be available.
+		 * \param account The account id.
+		 * \param startNonce The first nonce.
+		 * \return As many nonces as the kernel generates at once, every one in the PoC1 layout.
+		 */
+		static std::vector<std::vector<char>> generateNonces(const std::string& instructionSet, Poco::UInt64 account,
+			Poco::UInt64 startNonce);
 
 		static Poco::UInt64 calculateDeadlineSse2(std::vector<char>& gendata,
 			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
@@ -62,6 +73,10 @@ namespace Burst
 			std::array<std::vector<char>, Shabal256_AVX2::HashSize>& gendatas,
 			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
 
+		static std::array<Poco::UInt64, Shabal256_AVX512::HashSize> calculateDeadlineAvx512(
+			std::array<std::vector<char>, Shabal256_AVX512::HashSize>& gendatas,
+			GensigData& generationSignature, Poco::UInt64 scoop, Poco::UInt64 baseTarget);
+
 	private:
 		template <typename TShabal, typename TOperations>
 		static std::array<std::vector<char>, TShabal::HashSize> generate(const Poco::UInt64 account, const Poco::UInt64 startNonce)
@@ -234,4 +249,26 @@ namespace Burst
 				container[4], container[5], container[6], container[7]);
 		}
 	};
+
+	template <typename TShabal>
+	struct PlotGeneratorOperations16
+	{
+		template <typename TContainer>
+		static void update(TShabal& shabal, const TContainer& container, const Poco::UInt64 length)
+		{
+			shabal.update(container[0], container[1], container[2], container[3],
+				container[4], container[5], container[6], container[7],
+				container[8], container[9], container[10], container[11],
+				container[12], container[13], container[14], container[15], length);
+		}
+
+		template <typename TContainer>
+		static void close(TShabal& shabal, const TContainer& container)
+		{
+			shabal.close(container[0], container[1], container[2], container[3],
+				container[4], container[5], container[6], container[7],
+				container[8], container[9], container[10], container[11],
+				container[12], container[13], container[14], container[15]);
+		}
+	};
 }
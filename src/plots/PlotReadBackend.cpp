@@ -0,0 +1,498 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotReadBackend.hpp"
+#include "logging/MinerLogger.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+Burst::PlotFileHandle::PlotFileHandle(const std::string& path, const bool direct, const bool writable)
+	: direct_{direct}
+{
+#ifdef _WIN32
+	const DWORD access = writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+	const DWORD creation = writable ? OPEN_ALWAYS : OPEN_EXISTING;
+
+	handle_ = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, creation,
+		direct ? FILE_FLAG_NO_BUFFERING : FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (direct && handle_ == INVALID_HANDLE_VALUE)
+	{
+		handle_ = CreateFileA(path.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, creation,
+			FILE_ATTRIBUTE_NORMAL, nullptr);
+		direct_ = false;
+	}
+#else
+	const auto flags = writable ? O_RDWR | O_CREAT : O_RDONLY;
+
+#if defined __APPLE__
+	handle_ = open(path.c_str(), flags, 0644);
+
+	if (direct && handle_ >= 0)
+		direct_ = fcntl(handle_, F_NOCACHE, 1) == 0;
+#else
+	handle_ = open(path.c_str(), direct ? flags | O_DIRECT : flags, 0644);
+
+	// not every file system supports direct reads (tmpfs for example)
+	if (direct && handle_ < 0)
+	{
+		handle_ = open(path.c_str(), flags, 0644);
+		direct_ = false;
+	}
+#endif
+#endif
+
+	if (direct && !direct_ && isOpen())
+		log_debug(MinerLogger::plotReader, "Plot file %s can not be read directly, using buffered reads", path);
+}
+
+Burst::PlotFileHandle::~PlotFileHandle()
+{
+	if (!isOpen())
+		return;
+
+#ifdef _WIN32
+	CloseHandle(handle_);
+#else
+	close(handle_);
+#endif
+}
+
+bool Burst::PlotFileHandle::isOpen() const
+{
+#ifdef _WIN32
+	return handle_ != INVALID_HANDLE_VALUE;
+#else
+	return handle_ >= 0;
+#endif
+}
+
+bool Burst::PlotFileHandle::isDirect() const
+{
+	return direct_;
+}
+
+Poco::Int64 Burst::PlotFileHandle::read(void* buffer, const Poco::UInt64 size, const Poco::UInt64 offset) const
+{
+#ifdef _WIN32
+	OVERLAPPED overlapped{};
+	overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+	overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+	DWORD bytesRead = 0;
+
+	if (!ReadFile(handle_, buffer, static_cast<DWORD>(size), &bytesRead, &overlapped))
+		return -static_cast<Poco::Int64>(GetLastError());
+
+	return bytesRead;
+#else
+	const auto bytesRead = pread(handle_, buffer, size, static_cast<off_t>(offset));
+
+	if (bytesRead < 0)
+		return -errno;
+
+	return bytesRead;
+#endif
+}
+
+Poco::Int64 Burst::PlotFileHandle::write(const void* buffer, const Poco::UInt64 size, const Poco::UInt64 offset) const
+{
+#ifdef _WIN32
+	OVERLAPPED overlapped{};
+	overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+	overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+	DWORD bytesWritten = 0;
+
+	if (!WriteFile(handle_, buffer, static_cast<DWORD>(size), &bytesWritten, &overlapped))
+		return -static_cast<Poco::Int64>(GetLastError());
+
+	return bytesWritten;
+#else
+	const auto bytesWritten = pwrite(handle_, buffer, size, static_cast<off_t>(offset));
+
+	if (bytesWritten < 0)
+		return -errno;
+
+	return bytesWritten;
+#endif
+}
+
+bool Burst::PlotFileHandle::sync() const
+{
+#ifdef _WIN32
+	return FlushFileBuffers(handle_) != 0;
+#else
+	return fsync(handle_) == 0;
+#endif
+}
+
+bool Burst::PlotFileHandle::resize(const Poco::UInt64 size) const
+{
+#ifdef _WIN32
+	LARGE_INTEGER position;
+	position.QuadPart = static_cast<LONGLONG>(size);
+	return SetFilePointerEx(handle_, position, nullptr, FILE_BEGIN) && SetEndOfFile(handle_);
+#else
+	return ftruncate(handle_, static_cast<off_t>(size)) == 0;
+#endif
+}
+
+#ifdef _WIN32
+void* Burst::PlotFileHandle::getNativeHandle() const
+#else
+int Burst::PlotFileHandle::getNativeHandle() const
+#endif
+{
+	return handle_;
+}
+
+constexpr size_t Burst::PlotReadRequest::MaxSegments;
+
+Poco::UInt64 Burst::PlotReadRequest::getSize() const
+{
+	Poco::UInt64 size = 0;
+
+	for (const auto& segment : segments)
+		size += segment.size;
+
+	return size;
+}
+
+std::unique_ptr<Burst::PlotReadBackend> Burst::PlotReadBackend::create(unsigned queueDepth)
+{
+	if (queueDepth == 0)
+		queueDepth = 1;
+
+#ifdef USE_IO_URING
+	std::unique_ptr<PlotReadBackend_IoUring> ioUring(new PlotReadBackend_IoUring(queueDepth));
+
+	if (ioUring->isValid())
+		return std::move(ioUring);
+
+	log_debug(MinerLogger::plotReader, "io_uring is not supported by the kernel, falling back to pread");
+#endif
+
+	return std::unique_ptr<PlotReadBackend>(new PlotReadBackend_Pread(queueDepth));
+}
+
+Burst::PlotReadBackend_Pread::PlotReadBackend_Pread(const unsigned queueDepth)
+{
+	for (auto i = 0u; i < queueDepth; ++i)
+		workers_.emplace_back(&PlotReadBackend_Pread::work, this);
+}
+
+Burst::PlotReadBackend_Pread::~PlotReadBackend_Pread()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+
+	submittedCondition_.notify_all();
+
+	for (auto& worker : workers_)
+		worker.join();
+}
+
+void Burst::PlotReadBackend_Pread::submit(PlotReadRequest& request)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		submitted_.emplace_back(&request);
+		++pending_;
+	}
+
+	submittedCondition_.notify_one();
+}
+
+Burst::PlotReadRequest* Burst::PlotReadBackend_Pread::waitCompletion()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	if (pending_ == 0)
+		return nullptr;
+
+	completedCondition_.wait(lock, [this]() { return !completed_.empty(); });
+
+	const auto request = completed_.front();
+	completed_.pop_front();
+	--pending_;
+
+	return request;
+}
+
+size_t Burst::PlotReadBackend_Pread::getPending() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return pending_;
+}
+
+const char* Burst::PlotReadBackend_Pread::getName() const
+{
+	return "pread";
+}
+
+void Burst::PlotReadBackend_Pread::work()
+{
+	while (true)
+	{
+		PlotReadRequest* request;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			submittedCondition_.wait(lock, [this]() { return stop_ || !submitted_.empty(); });
+
+			if (stop_)
+				return;
+
+			request = submitted_.front();
+			submitted_.pop_front();
+		}
+
+		request->error = 0;
+		request->success = true;
+
+		// the segments are read one after another by the same thread, so the disk sees them in offset order
+		for (auto segment = request->segments.begin(); segment != request->segments.end() && request->success; ++segment)
+		{
+			segment->bytesRead = 0;
+
+			// a positional read can return less bytes than requested, so we read until the block is complete
+			while (segment->bytesRead < segment->size)
+			{
+				const auto bytesRead = request->file->read(request->buffer + segment->bufferOffset + segment->bytesRead,
+					segment->size - segment->bytesRead, segment->offset + segment->bytesRead);
+
+				if (bytesRead <= 0)
+				{
+					request->error = static_cast<int>(-bytesRead);
+					break;
+				}
+
+				segment->bytesRead += bytesRead;
+			}
+
+			request->success = segment->bytesRead == segment->size;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			completed_.emplace_back(request);
+		}
+
+		completedCondition_.notify_one();
+	}
+}
+
+#ifdef USE_IO_URING
+Burst::PlotReadBackend_IoUring::PlotReadBackend_IoUring(const unsigned queueDepth)
+	: queueDepth_{queueDepth}
+{
+	valid_ = init();
+}
+
+Burst::PlotReadBackend_IoUring::~PlotReadBackend_IoUring()
+{
+	if (valid_)
+		io_uring_queue_exit(&ring_);
+}
+
+bool Burst::PlotReadBackend_IoUring::isValid() const
+{
+	return valid_;
+}
+
+void Burst::PlotReadBackend_IoUring::submit(PlotReadRequest& request)
+{
+	// the ring could not be rebuilt after an error, so the reads are done by pread
+	if (fallback_ != nullptr)
+	{
+		fallback_->submit(request);
+		return;
+	}
+
+	request.error = 0;
+	request.success = true;
+	request.pendingSegments = request.segments.size();
+	++pending_;
+
+	for (auto& segment : request.segments)
+	{
+		segment.bytesRead = 0;
+		segment.request = &request;
+		prepare(segment);
+	}
+
+	// all segments of the request go to the kernel with one syscall
+	io_uring_submit(&ring_);
+	inFlight_.emplace_back(&request);
+}
+
+Burst::PlotReadRequest* Burst::PlotReadBackend_IoUring::waitCompletion()
+{
+	while (pending_ > 0)
+	{
+		// failed requests are handed back first, so the caller can release their buffers
+		if (!failed_.empty())
+		{
+			const auto request = failed_.front();
+			failed_.pop_front();
+			--pending_;
+			return request;
+		}
+
+		io_uring_cqe* cqe = nullptr;
+		const auto result = io_uring_wait_cqe(&ring_, &cqe);
+
+		if (result == -EINTR)
+			continue;
+
+		if (result < 0)
+		{
+			failAll(-result);
+			continue;
+		}
+
+		auto& segment = *static_cast<PlotReadSegment*>(io_uring_cqe_get_data(cqe));
+		auto& request = *segment.request;
+		const auto bytesRead = cqe->res;
+		io_uring_cqe_seen(&ring_, cqe);
+
+		if (bytesRead > 0)
+			segment.bytesRead += bytesRead;
+		else
+			request.error = -bytesRead;
+
+		// short read, queue the rest of the block again
+		// with direct reads the rest would start at an unaligned offset, so the block counts as failed
+		if (bytesRead > 0 && segment.bytesRead < segment.size && !request.file->isDirect())
+		{
+			prepare(segment);
+			io_uring_submit(&ring_);
+			continue;
+		}
+
+		request.success = request.success && segment.bytesRead == segment.size;
+
+		if (--request.pendingSegments > 0)
+			continue;
+
+		inFlight_.erase(std::find(inFlight_.begin(), inFlight_.end(), &request));
+		--pending_;
+
+		return &request;
+	}
+
+	if (fallback_ != nullptr)
+		return fallback_->waitCompletion();
+
+	return nullptr;
+}
+
+bool Burst::PlotReadBackend_IoUring::init()
+{
+	// every request in flight can occupy one entry per segment
+	const auto entries = std::min<unsigned>(queueDepth_ * PlotReadRequest::MaxSegments, 4096);
+
+	if (io_uring_queue_init(entries, &ring_, 0) != 0)
+		return false;
+
+	// the read operation needs a kernel 5.6 or newer, older kernels complete every read with EINVAL
+	// (they can not be probed at all, what also means, that the operation is missing)
+	const auto probe = io_uring_get_probe_ring(&ring_);
+	const auto supported = probe != nullptr && io_uring_opcode_supported(probe, IORING_OP_READ);
+
+	if (probe != nullptr)
+		io_uring_free_probe(probe);
+
+	if (!supported)
+		io_uring_queue_exit(&ring_);
+
+	return supported;
+}
+
+void Burst::PlotReadBackend_IoUring::fail(PlotReadRequest& request, const int error)
+{
+	request.success = false;
+	request.error = error;
+	request.pendingSegments = 0;
+	failed_.emplace_back(&request);
+}
+
+void Burst::PlotReadBackend_IoUring::failAll(const int error)
+{
+	// tearing down the ring waits for the reads inside the kernel, so no buffer is written after this
+	io_uring_queue_exit(&ring_);
+
+	for (auto request : inFlight_)
+		fail(*request, error);
+
+	inFlight_.clear();
+
+	// only the reads in flight are lost, the following ones go to a new ring or to pread
+	valid_ = init();
+
+	if (valid_)
+	{
+		log_warning(MinerLogger::plotReader, "Could not wait for a completed read (error %d), the io_uring was rebuilt", error);
+		return;
+	}
+
+	log_warning(MinerLogger::plotReader, "Could not wait for a completed read (error %d), falling back to pread", error);
+	fallback_.reset(new PlotReadBackend_Pread(queueDepth_));
+}
+
+size_t Burst::PlotReadBackend_IoUring::getPending() const
+{
+	return pending_ + (fallback_ != nullptr ? fallback_->getPending() : 0);
+}
+
+const char* Burst::PlotReadBackend_IoUring::getName() const
+{
+	return "io_uring";
+}
+
+void Burst::PlotReadBackend_IoUring::prepare(PlotReadSegment& segment)
+{
+	auto sqe = io_uring_get_sqe(&ring_);
+
+	// the submission queue is full, push the pending entries to the kernel
+	while (sqe == nullptr)
+	{
+		io_uring_submit(&ring_);
+		sqe = io_uring_get_sqe(&ring_);
+	}
+
+	const auto& request = *segment.request;
+
+	io_uring_prep_read(sqe, request.file->getNativeHandle(), request.buffer + segment.bufferOffset + segment.bytesRead,
+		static_cast<unsigned>(segment.size - segment.bytesRead), segment.offset + segment.bytesRead);
+	io_uring_sqe_set_data(sqe, &segment);
+}
+#endif
@@ -0,0 +1,248 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <string>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef USE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace Burst
+{
+	/**
+	 * \brief A plot file that is opened for positional reads (and writes).
+	 * Every read is independent of the others, so many of them can be in flight at the same time.
+	 */
+	class PlotFileHandle
+	{
+	public:
+		/**
+		 * \brief Opens a plot file.
+		 * \param path The path of the plot file.
+		 * \param direct If true, the file is opened for direct (unbuffered) reads that bypass the page cache.
+		 * If the file system does not support it, the file is opened for buffered reads.
+		 * \param writable If true, the file is opened for reading and writing and created, if it does not exist.
+		 */
+		explicit PlotFileHandle(const std::string& path, bool direct = false, bool writable = false);
+		~PlotFileHandle();
+
+		PlotFileHandle(const PlotFileHandle&) = delete;
+		PlotFileHandle& operator=(const PlotFileHandle&) = delete;
+
+		bool isOpen() const;
+
+		/**
+		 * \brief Returns true, if the file is opened for direct reads.
+		 * Then the offset, the size and the buffer of every read need to be aligned to BufferArena::Alignment.
+		 */
+		bool isDirect() const;
+
+		/**
+		 * \brief Reads a block of the file (blocking).
+		 * \param buffer The destination.
+		 * \param size The amount of bytes to read.
+		 * \param offset The offset in the file.
+		 * \return The amount of bytes read or a negative value on error.
+		 */
+		Poco::Int64 read(void* buffer, Poco::UInt64 size, Poco::UInt64 offset) const;
+
+		/**
+		 * \brief Writes a block into the file (blocking).
+		 * \param buffer The source.
+		 * \param size The amount of bytes to write.
+		 * \param offset The offset in the file.
+		 * \return The amount of bytes written or a negative value on error.
+		 */
+		Poco::Int64 write(const void* buffer, Poco::UInt64 size, Poco::UInt64 offset) const;
+
+		/**
+		 * \brief Writes all data of the file from the operating system cache to the disk.
+		 * \return true, if the data is on the disk.
+		 */
+		bool sync() const;
+
+		/**
+		 * \brief Sets the size of the file.
+		 * \param size The new size in bytes.
+		 * \return true on success.
+		 */
+		bool resize(Poco::UInt64 size) const;
+
+#ifdef _WIN32
+		void* getNativeHandle() const;
+#else
+		int getNativeHandle() const;
+#endif
+
+	private:
+#ifdef _WIN32
+		void* handle_;
+#else
+		int handle_;
+#endif
+		bool direct_;
+	};
+
+	struct PlotReadRequest;
+
+	/**
+	 * \brief A contiguous block of a plot file, that is read into the buffer of a request.
+	 */
+	struct PlotReadSegment
+	{
+		Poco::UInt64 offset = 0;
+		Poco::UInt64 size = 0;
+		Poco::UInt64 bufferOffset = 0;
+		Poco::UInt64 bytesRead = 0;
+		PlotReadRequest* request = nullptr;
+	};
+
+	/**
+	 * \brief A read of one or more blocks inside a plot file into one buffer.
+	 * The segments are submitted together and should be ordered by their offset in the file.
+	 * The request is owned by the caller and has to stay alive until it is completed.
+	 */
+	struct PlotReadRequest
+	{
+		const PlotFileHandle* file = nullptr;
+		char* buffer = nullptr;
+		std::vector<PlotReadSegment> segments;
+		size_t pendingSegments = 0;
+		bool success = false;
+		int error = 0;
+		void* userData = nullptr;
+
+		/**
+		 * \brief Returns the sum of the sizes of all segments.
+		 */
+		Poco::UInt64 getSize() const;
+
+		/**
+		 * \brief The maximal amount of segments of one request.
+		 */
+		static constexpr size_t MaxSegments = 128;
+	};
+
+	/**
+	 * \brief Executes plot read requests asynchronously.
+	 * Every plot reader owns one backend, that keeps up to queueDepth reads in flight.
+	 */
+	class PlotReadBackend
+	{
+	public:
+		virtual ~PlotReadBackend() = default;
+
+		/**
+		 * \brief Queues a read request with all of its segments. Never blocks.
+		 * \param request The request, that needs to be executed.
+		 */
+		virtual void submit(PlotReadRequest& request) = 0;
+
+		/**
+		 * \brief Waits until one of the submitted requests is completed.
+		 * \return The completed request or nullptr, if there is no pending request.
+		 */
+		virtual PlotReadRequest* waitCompletion() = 0;
+
+		/**
+		 * \brief Returns the amount of submitted, but not yet returned requests.
+		 */
+		virtual size_t getPending() const = 0;
+
+		virtual const char* getName() const = 0;
+
+		/**
+		 * \brief Creates the best backend that is available on this system.
+		 * \param queueDepth The maximal amount of reads in flight.
+		 * \return The backend (io_uring if compiled in and supported by the kernel, pread threads otherwise).
+		 */
+		static std::unique_ptr<PlotReadBackend> create(unsigned queueDepth);
+	};
+
+	/**
+	 * \brief Fallback backend, that executes the reads with blocking positional reads inside a small thread pool.
+	 */
+	class PlotReadBackend_Pread : public PlotReadBackend
+	{
+	public:
+		explicit PlotReadBackend_Pread(unsigned queueDepth);
+		~PlotReadBackend_Pread() override;
+
+		void submit(PlotReadRequest& request) override;
+		PlotReadRequest* waitCompletion() override;
+		size_t getPending() const override;
+		const char* getName() const override;
+
+	private:
+		void work();
+
+		std::vector<std::thread> workers_;
+		std::deque<PlotReadRequest*> submitted_, completed_;
+		size_t pending_ = 0;
+		bool stop_ = false;
+		mutable std::mutex mutex_;
+		std::condition_variable submittedCondition_, completedCondition_;
+	};
+
+#ifdef USE_IO_URING
+	/**
+	 * \brief Backend, that hands the reads directly to the kernel by using io_uring.
+	 * One thread can keep a whole queue of reads in flight with only one syscall per submission.
+	 * If the ring breaks, it is rebuilt, or if that fails, the reads are done by the pread backend.
+	 */
+	class PlotReadBackend_IoUring : public PlotReadBackend
+	{
+	public:
+		explicit PlotReadBackend_IoUring(unsigned queueDepth);
+		~PlotReadBackend_IoUring() override;
+
+		bool isValid() const;
+
+		void submit(PlotReadRequest& request) override;
+		PlotReadRequest* waitCompletion() override;
+		size_t getPending() const override;
+		const char* getName() const override;
+
+	private:
+		bool init();
+		void prepare(PlotReadSegment& segment);
+		void fail(PlotReadRequest& request, int error);
+		void failAll(int error);
+
+		io_uring ring_;
+		bool valid_;
+		unsigned queueDepth_;
+		size_t pending_ = 0;
+		std::unique_ptr<PlotReadBackend> fallback_;
+		std::vector<PlotReadRequest*> inFlight_;
+		std::deque<PlotReadRequest*> failed_;
+	};
+#endif
+}
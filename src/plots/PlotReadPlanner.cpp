@@ -0,0 +1,202 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotReadPlanner.hpp"
+#include "PlotReadBackend.hpp"
+#include "BufferArena.hpp"
+#include "Plot.hpp"
+#include <cstring>
+#include <algorithm>
+
+constexpr Poco::UInt64 Burst::PlotReadPlanner::MaxMirrorGap;
+
+Poco::UInt64 Burst::PlotReadPlanner::getChunkNonces(const PlotFile& plotFile, const Poco::UInt64 startNonce,
+	const Poco::UInt64 bufferSize, const bool mirror, const bool direct)
+{
+	const auto staggerSize = plotFile.getStaggerSize();
+	const auto staggerRest = std::min(staggerSize - startNonce % staggerSize, plotFile.getNonces() - startNonce);
+
+	// the chunk needs to fit into the buffer with the scoops, the mirror scoops and the alignment of direct reads
+	const auto alignmentBytes = direct ? 2 * BufferArena::Alignment : 0;
+	const auto chunkBytes = mirror ? bufferSize / 2 : bufferSize;
+	const auto nonces = std::min(chunkBytes > alignmentBytes ? (chunkBytes - alignmentBytes) / Settings::ScoopSize : 0,
+		plotFile.getNonces() - startNonce);
+
+	if (nonces <= staggerRest)
+		return std::max(nonces, Poco::UInt64{1});
+
+	// the blocks of the staggers are packed into the buffer, so direct reads must not widen them
+	const auto aligned = [](const Poco::UInt64 bytes)
+	{
+		return bytes % BufferArena::Alignment == 0;
+	};
+
+	if (direct && !(aligned(plotFile.getStaggerScoopBytes()) && aligned(startNonce % staggerSize * Settings::ScoopSize) &&
+		aligned(staggerRest * Settings::ScoopSize)))
+		return staggerRest;
+
+	// the chunk ends at the end of a stagger, the next chunk reads whole staggers again
+	const auto segmentsPerStagger = mirror ? 2 : 1;
+	const auto maxStaggers = PlotReadRequest::MaxSegments / segmentsPerStagger - 1;
+	const auto staggers = std::min<Poco::UInt64>((nonces - staggerRest) / staggerSize, maxStaggers);
+
+	return staggerRest + staggers * staggerSize;
+}
+
+Burst::PlotReadPlan Burst::PlotReadPlanner::plan(PlotReadRequest& request, const PlotFile& plotFile, const Poco::UInt32 scoop,
+	const Poco::UInt64 startNonce, const Poco::UInt64 nonces, const bool mirror, const bool direct, const Poco::UInt64 maxBufferSize)
+{
+	PlotReadPlan plan;
+	plan.nonces = nonces;
+	plan.mirror = mirror;
+
+	const auto bytesToRead = nonces * Settings::ScoopSize;
+	const auto staggerBlockOffset = startNonce / plotFile.getStaggerSize() * plotFile.getStaggerBytes();
+	const auto chunkOffset = startNonce % plotFile.getStaggerSize() * Settings::ScoopSize;
+	const auto scoopsOffset = staggerBlockOffset + scoop * plotFile.getStaggerScoopBytes() + chunkOffset;
+
+	// direct reads need an aligned offset and size, so we widen the reads to the alignment
+	// and remember where the wanted bytes are inside the buffer
+	const auto begin = [direct](const Poco::UInt64 offset)
+	{
+		return direct ? BufferArena::alignDown(offset) : offset;
+	};
+
+	const auto end = [direct](const Poco::UInt64 offset)
+	{
+		return direct ? BufferArena::alignUp(offset) : offset;
+	};
+
+	request.segments.clear();
+
+	if (startNonce % plotFile.getStaggerSize() + nonces > plotFile.getStaggerSize())
+		return planStaggers(request, plotFile, scoop, startNonce, nonces, mirror);
+
+	if (!mirror)
+	{
+		PlotReadSegment segment;
+		segment.offset = begin(scoopsOffset);
+		segment.size = end(scoopsOffset + bytesToRead) - segment.offset;
+		request.segments.emplace_back(segment);
+
+		plan.bufferSize = segment.size;
+		plan.scoopsOffset = scoopsOffset - segment.offset;
+		return plan;
+	}
+
+	const auto mirrorOffset = staggerBlockOffset + (4095 - scoop) * plotFile.getStaggerScoopBytes() + chunkOffset;
+	const auto firstOffset = std::min(scoopsOffset, mirrorOffset);
+	const auto secondOffset = std::max(scoopsOffset, mirrorOffset);
+
+	PlotReadSegment first, second;
+	first.offset = begin(firstOffset);
+	first.size = end(firstOffset + bytesToRead) - first.offset;
+	second.offset = begin(secondOffset);
+	second.size = end(secondOffset + bytesToRead) - second.offset;
+
+	// both scoops are close to each other, one bigger read is faster than two small ones
+	if (second.offset <= first.offset + first.size + MaxMirrorGap &&
+		second.offset + second.size - first.offset <= maxBufferSize)
+	{
+		first.size = second.offset + second.size - first.offset;
+		request.segments.emplace_back(first);
+
+		plan.bufferSize = first.size;
+		plan.scoopsOffset = scoopsOffset - first.offset;
+		plan.mirrorOffset = mirrorOffset - first.offset;
+		return plan;
+	}
+
+	// the second segment is put directly behind the first one in the buffer
+	second.bufferOffset = first.size;
+	request.segments.emplace_back(first);
+	request.segments.emplace_back(second);
+
+	plan.bufferSize = first.size + second.size;
+
+	const auto& scoopsSegment = scoopsOffset < mirrorOffset ? first : second;
+	const auto& mirrorSegment = scoopsOffset < mirrorOffset ? second : first;
+
+	plan.scoopsOffset = scoopsSegment.bufferOffset + scoopsOffset - scoopsSegment.offset;
+	plan.mirrorOffset = mirrorSegment.bufferOffset + mirrorOffset - mirrorSegment.offset;
+	return plan;
+}
+
+Burst::PlotReadPlan Burst::PlotReadPlanner::planStaggers(PlotReadRequest& request, const PlotFile& plotFile,
+	const Poco::UInt32 scoop, const Poco::UInt64 startNonce, const Poco::UInt64 nonces, const bool mirror)
+{
+	PlotReadPlan plan;
+	plan.nonces = nonces;
+	plan.mirror = mirror;
+	plan.bufferSize = nonces * Settings::ScoopSize * (mirror ? 2 : 1);
+	plan.scoopsOffset = 0;
+	plan.mirrorOffset = nonces * Settings::ScoopSize;
+
+	const auto staggerSize = plotFile.getStaggerSize();
+
+	// one segment per stagger, the scoops and the mirror scoops are packed into their own halves of the buffer
+	for (auto nonce = startNonce; nonce < startNonce + nonces;)
+	{
+		const auto staggerNonces = std::min(staggerSize - nonce % staggerSize, startNonce + nonces - nonce);
+		const auto staggerBlockOffset = nonce / staggerSize * plotFile.getStaggerBytes();
+		const auto chunkOffset = nonce % staggerSize * Settings::ScoopSize;
+
+		PlotReadSegment scoopSegment;
+		scoopSegment.offset = staggerBlockOffset + scoop * plotFile.getStaggerScoopBytes() + chunkOffset;
+		scoopSegment.size = staggerNonces * Settings::ScoopSize;
+		scoopSegment.bufferOffset = plan.scoopsOffset + (nonce - startNonce) * Settings::ScoopSize;
+
+		if (mirror)
+		{
+			auto mirrorSegment = scoopSegment;
+			mirrorSegment.offset = staggerBlockOffset + (4095 - scoop) * plotFile.getStaggerScoopBytes() + chunkOffset;
+			mirrorSegment.bufferOffset = plan.mirrorOffset + (nonce - startNonce) * Settings::ScoopSize;
+
+			// ordered by their offset, so the disk does not need to seek back inside the stagger
+			if (mirrorSegment.offset < scoopSegment.offset)
+				std::swap(scoopSegment, mirrorSegment);
+
+			request.segments.emplace_back(scoopSegment);
+			request.segments.emplace_back(mirrorSegment);
+		}
+		else
+			request.segments.emplace_back(scoopSegment);
+
+		nonce += staggerNonces;
+	}
+
+	return plan;
+}
+
+Burst::ScoopData* Burst::PlotReadPlanner::assemble(const PlotReadPlan& plan, char* buffer)
+{
+	const auto scoops = reinterpret_cast<ScoopData*>(buffer + plan.scoopsOffset);
+
+	if (plan.mirror)
+	{
+		const auto scoopsMirror = reinterpret_cast<const ScoopData*>(buffer + plan.mirrorOffset);
+
+		for (size_t i = 0; i < plan.nonces; ++i)
+			memcpy(&scoops[i][32], &scoopsMirror[i][32], 32);
+	}
+
+	return scoops;
+}
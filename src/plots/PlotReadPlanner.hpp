@@ -0,0 +1,102 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include "Declarations.hpp"
+
+namespace Burst
+{
+	class PlotFile;
+	struct PlotReadRequest;
+
+	/**
+	 * \brief Describes where the scoops of a planned chunk are inside the read buffer.
+	 */
+	struct PlotReadPlan
+	{
+		Poco::UInt64 bufferSize = 0;
+		Poco::UInt64 scoopsOffset = 0;
+		Poco::UInt64 mirrorOffset = 0;
+		Poco::UInt64 nonces = 0;
+		bool mirror = false;
+	};
+
+	/**
+	 * \brief Plans the reads of one chunk of a plot file.
+	 * A chunk of a plot, that has another PoC version than the current block, needs the scoop and its mirror scoop
+	 * (4095 - scoop). Both are read by one request, either as one contiguous block, when they are close to each other,
+	 * or as two segments ordered by their offset in the file, so the disk does not need to seek back.
+	 * The scoops of an unoptimized plot file are split into small blocks, one per stagger. A chunk of such a file
+	 * covers many staggers and all of their blocks are read by one request, one segment per stagger (and mirror scoop),
+	 * packed into the buffer, so the nonces of the chunk are contiguous again.
+	 */
+	class PlotReadPlanner
+	{
+	public:
+		/**
+		 * \brief Returns the amount of nonces of the next chunk.
+		 * The chunk is as big as the buffer allows. It ends at the end of a stagger, if it crosses one and it covers
+		 * only whole staggers after its first one. With direct reads, a chunk only crosses staggers, whose blocks are aligned.
+		 * \param plotFile The plot file.
+		 * \param startNonce The first nonce of the chunk (relative to the plot file).
+		 * \param bufferSize The size of the buffer, that holds the chunk.
+		 * \param mirror If true, the mirror scoop is read too.
+		 * \param direct If true, the chunk is read by direct reads.
+		 * \return The amount of nonces.
+		 */
+		static Poco::UInt64 getChunkNonces(const PlotFile& plotFile, Poco::UInt64 startNonce, Poco::UInt64 bufferSize,
+			bool mirror, bool direct);
+
+		/**
+		 * \brief Fills the segments of a request.
+		 * \param request The request, that gets the segments. The buffer needs to be set by the caller.
+		 * \param plotFile The plot file.
+		 * \param scoop The scoop of the current block.
+		 * \param startNonce The first nonce of the chunk (relative to the plot file).
+		 * \param nonces The amount of nonces in the chunk, as returned by getChunkNonces().
+		 * \param mirror If true, the mirror scoop is read too.
+		 * \param direct If true, all segments are aligned for direct reads.
+		 * \param maxBufferSize The size of the buffer. Scoop and mirror scoop are only read as one block, if it fits.
+		 * \return The plan, that is needed to assemble the chunk after the read.
+		 */
+		static PlotReadPlan plan(PlotReadRequest& request, const PlotFile& plotFile, Poco::UInt32 scoop,
+			Poco::UInt64 startNonce, Poco::UInt64 nonces, bool mirror, bool direct, Poco::UInt64 maxBufferSize);
+
+		/**
+		 * \brief Puts the second hashes of the mirror scoops into the scoops, so the chunk can be verified.
+		 * \param plan The plan of the chunk.
+		 * \param buffer The buffer of the completed request.
+		 * \return The scoops inside the buffer.
+		 */
+		static ScoopData* assemble(const PlotReadPlan& plan, char* buffer);
+
+		/**
+		 * \brief Scoop and mirror scoop are read as one block, if the bytes between them are not more than this.
+		 */
+		static constexpr Poco::UInt64 MaxMirrorGap = 1024 * 1024;
+
+	private:
+		static PlotReadPlan planStaggers(PlotReadRequest& request, const PlotFile& plotFile, Poco::UInt32 scoop,
+			Poco::UInt64 startNonce, Poco::UInt64 nonces, bool mirror);
+	};
+}
@@ -0,0 +1,123 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotReadScheduler.hpp"
+
+void Burst::PlotReadScheduler::enqueue(PlotReadNotification::Ptr notification)
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		devices_[notification->device].queue.emplace_back(notification);
+	}
+
+	condition_.notify_all();
+}
+
+Burst::PlotReadNotification::Ptr Burst::PlotReadScheduler::waitDequeue()
+{
+	std::unique_lock<std::mutex> lock{mutex_};
+	const auto wakeUps = wakeUps_;
+
+	while (wakeUps == wakeUps_)
+	{
+		// start behind the device, that was handed out last, so every device gets its turn
+		auto device = devices_.upper_bound(lastDevice_);
+		auto chosen = devices_.end();
+
+		for (size_t i = 0; i < devices_.size(); ++i, ++device)
+		{
+			if (device == devices_.end())
+				device = devices_.begin();
+
+			auto& queue = device->second.queue;
+
+			if (queue.empty())
+				continue;
+
+			const auto free = device->second.readers == 0 || queue.front()->type == PlotDir::Type::Parallel;
+
+			// prefer the devices with the least readers
+			if (free && (chosen == devices_.end() || device->second.readers < chosen->second.readers))
+				chosen = device;
+		}
+
+		if (chosen != devices_.end())
+		{
+			auto notification = chosen->second.queue.front();
+			chosen->second.queue.pop_front();
+			++chosen->second.readers;
+			lastDevice_ = chosen->first;
+			return notification;
+		}
+
+		condition_.wait(lock);
+	}
+
+	return nullptr;
+}
+
+void Burst::PlotReadScheduler::finished(const PlotReadNotification& notification)
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		auto& device = devices_[notification.device];
+
+		if (device.readers > 0)
+			--device.readers;
+	}
+
+	condition_.notify_all();
+}
+
+void Burst::PlotReadScheduler::clear()
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+
+	for (auto& device : devices_)
+		device.second.queue.clear();
+}
+
+void Burst::PlotReadScheduler::wakeUpAll()
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		++wakeUps_;
+	}
+
+	condition_.notify_all();
+}
+
+size_t Burst::PlotReadScheduler::size() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	size_t size = 0;
+
+	for (const auto& device : devices_)
+		size += device.second.queue.size();
+
+	return size;
+}
+
+size_t Burst::PlotReadScheduler::getDeviceCount() const
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	return devices_.size();
+}
@@ -0,0 +1,94 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include "PlotReader.hpp"
+#include <map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace Burst
+{
+	/**
+	 * \brief Distributes the plot read notifications between the plot readers.
+	 * Every notification belongs to the physical device of its plot directory. A sequential
+	 * notification is only handed out when no other reader is reading from its device,
+	 * so two readers never seek against each other on the same disk, while the other disks are idle.
+	 * Parallel notifications are always handed out, because the user wants their device to be read in parallel.
+	 */
+	class PlotReadScheduler
+	{
+	public:
+		/**
+		 * \brief Adds a notification to the queue of its device.
+		 * \param notification The notification.
+		 */
+		void enqueue(PlotReadNotification::Ptr notification);
+
+		/**
+		 * \brief Waits for a notification, whose device is free.
+		 * The caller has to call finished() with the notification, when it is processed.
+		 * \return The notification or nullptr, if the waiting readers were woken up by wakeUpAll().
+		 */
+		PlotReadNotification::Ptr waitDequeue();
+
+		/**
+		 * \brief Marks the device of a notification as free again.
+		 * \param notification The notification, that was returned by waitDequeue().
+		 */
+		void finished(const PlotReadNotification& notification);
+
+		/**
+		 * \brief Removes all queued notifications.
+		 */
+		void clear();
+
+		/**
+		 * \brief Wakes up all waiting readers, waitDequeue() returns nullptr for them.
+		 */
+		void wakeUpAll();
+
+		/**
+		 * \brief Returns the amount of queued notifications.
+		 */
+		size_t size() const;
+
+		/**
+		 * \brief Returns the amount of devices, that have been seen by the scheduler.
+		 */
+		size_t getDeviceCount() const;
+
+	private:
+		struct Device
+		{
+			std::deque<PlotReadNotification::Ptr> queue;
+			unsigned readers = 0;
+		};
+
+		std::map<std::string, Device> devices_;
+		std::string lastDevice_;
+		Poco::UInt64 wakeUps_ = 0;
+		mutable std::mutex mutex_;
+		std::condition_variable condition_;
+	};
+}
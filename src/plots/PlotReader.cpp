@@ -20,11 +20,17 @@
 // ==========================================================================
 
 #include "PlotReader.hpp"
+#include "PlotReadBackend.hpp"
+#include "PlotReadPlanner.hpp"
+#include "PlotReadScheduler.hpp"
+#include "PlotCache.hpp"
+#include "VerificationQueue.hpp"
 #include "MinerUtil.hpp"
 #include "logging/MinerLogger.hpp"
 #include "mining/MinerConfig.hpp"
-#include <fstream>
+#include "mining/Numa.hpp"
 #include <utility>
+#include <algorithm>
 #include "mining/Miner.hpp"
 #include <Poco/NotificationQueue.h>
 #include "PlotVerifier.hpp"
@@ -34,40 +40,96 @@
 #include "logging/Performance.hpp"
 
 Burst::GlobalBufferSize Burst::PlotReader::globalBufferSize;
+Burst::BufferArena Burst::PlotReader::bufferArena;
+
+void Burst::FusedVerifier::setFunction(VerifyFunction function)
+{
+	std::lock_guard<std::mutex> lock{mutex_};
+	function_ = function ? std::make_shared<VerifyFunction>(std::move(function)) : nullptr;
+}
+
+bool Burst::FusedVerifier::verify(VerifyNotification& notification, const std::function<bool()>& stop) const
+{
+	std::shared_ptr<VerifyFunction> function;
+
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		function = function_;
+	}
+
+	if (function == nullptr)
+		return false;
+
+	(*function)(notification, stop);
+	return true;
+}
 
 void Burst::GlobalBufferSize::setMax(const Poco::UInt64 max)
 {
-	Poco::FastMutex::ScopedLock lock{mutex_};
 	max_ = max;
+
+	// a bigger budget can be enough for the waiting readers
+	std::lock_guard<std::mutex> lock{mutex_};
+	freed_.notify_all();
 }
 
 bool Burst::GlobalBufferSize::reserve(const Poco::UInt64 size)
 {
+	const auto max = max_.load();
+
 	// unlimited memory
-	if (MinerConfig::getConfig().getMaxBufferSize() == 0)
+	if (max == 0)
+	{
+		size_ += size;
 		return true;
+	}
 
-	Poco::FastMutex::ScopedLock lock{mutex_};
+	auto reserved = size_.load();
 
-	if (size_ + size > max_)
-		return false;
+	do
+	{
+		if (reserved + size > max)
+			return false;
+	}
+	while (!size_.compare_exchange_weak(reserved, reserved + size));
 
-	size_ += size;
 	return true;
 }
 
-void Burst::GlobalBufferSize::free(Poco::UInt64 size)
+bool Burst::GlobalBufferSize::reserve(const Poco::UInt64 size, const std::chrono::milliseconds timeout)
 {
-	// unlimited memory
-	if (MinerConfig::getConfig().getMaxBufferSize() == 0)
-		return;
+	if (reserve(size))
+		return true;
+
+	const auto start = std::chrono::steady_clock::now();
+	auto reserved = false;
+
+	{
+		std::unique_lock<std::mutex> lock{mutex_};
+		++waiting_;
+		reserved = freed_.wait_until(lock, start + timeout, [this, size]() { return reserve(size); });
+		--waiting_;
+	}
+
+	waitTime_ += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	++waitCount_;
+
+	return reserved;
+}
 
-	Poco::FastMutex::ScopedLock lock{mutex_};
+void Burst::GlobalBufferSize::free(Poco::UInt64 size)
+{
+	auto reserved = size_.load();
 
-	if (size > size_)
-		size = size_;
+	while (!size_.compare_exchange_weak(reserved, reserved - std::min(size, reserved)))
+		;
 
-	size_ -= size;
+	// only take the lock when somebody waits for the memory
+	if (waiting_ > 0)
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		freed_.notify_all();
+	}
 }
 
 Poco::UInt64 Burst::GlobalBufferSize::getSize() const
@@ -80,29 +142,110 @@ Poco::UInt64 Burst::GlobalBufferSize::getMax() const
 	return max_;
 }
 
-Burst::PlotReader::PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progress,
-                              Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue)
-	: Task("PlotReader"), data_(data), progress_{std::move(progress)}, verificationQueue_{&verificationQueue},
-	  plotReadQueue_(&plotReadQueue)
+Poco::UInt64 Burst::GlobalBufferSize::getWaitTime() const
+{
+	return waitTime_;
+}
+
+Poco::UInt64 Burst::GlobalBufferSize::getWaitCount() const
+{
+	return waitCount_;
+}
+
+void Burst::GlobalBufferSize::resetWaitStatistics()
+{
+	waitTime_ = 0;
+	waitCount_ = 0;
+}
+
+namespace Burst
+{
+	/**
+	 * \brief A chunk of a plot file, that is read asynchronously.
+	 * When its request is completed, the chunk is handed to the verifiers.
+	 */
+	struct PlotReadJob
+	{
+		VerifyNotification::Ptr verification;
+		PlotReadRequest request;
+		PlotReadPlan plan;
+	};
+
+	/**
+	 * \brief Gives the device of a plot read notification free, when the notification is processed.
+	 */
+	struct PlotReadDeviceLock
+	{
+		PlotReadScheduler& scheduler;
+		const PlotReadNotification& notification;
+
+		~PlotReadDeviceLock()
+		{
+			scheduler.finished(notification);
+		}
+	};
+}
+
+Burst::PlotReader::PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progressRead,
+                              std::shared_ptr<PlotReadProgress> progressVerify, VerificationQueue& verificationQueue,
+                              FusedVerifier& fusedVerifier, PlotReadScheduler& plotReadScheduler)
+	: Task("PlotReader"), data_(data), progress_{std::move(progressRead)}, progressVerify_{std::move(progressVerify)},
+	  verificationQueue_{&verificationQueue}, fusedVerifier_{&fusedVerifier}, plotReadScheduler_(&plotReadScheduler)
 {
 }
 
 void Burst::PlotReader::runTask()
 {
-	std::vector<ScoopData> bufferMirror;
+	const auto queueDepth = std::max(MinerConfig::getConfig().getReadQueueDepth(), 1u);
+	const auto backend = PlotReadBackend::create(queueDepth);
+
+	std::vector<std::unique_ptr<PlotReadJob>> jobs;
+	std::vector<PlotReadJob*> freeJobs;
+
+	for (auto i = 0u; i < queueDepth; ++i)
+	{
+		jobs.emplace_back(new PlotReadJob);
+		freeJobs.emplace_back(jobs.back().get());
+	}
+
+	log_debug(MinerLogger::plotReader, "Plot reader uses %s with a queue depth of %u", std::string(backend->getName()), queueDepth);
+
+	// the reader is pinned to its NUMA node, so its buffers are allocated there
+	const auto node = MinerConfig::getConfig().isNumaAware() ? Numa::instance().pinThread(Numa::Pool::Reader) : BufferArena::AnyNode;
+
+	// a slot can only be missing, when the system is out of memory, so we back off until the verifiers freed some
+	const auto allocate = [this, node](BufferSlot& slot)
+	{
+		auto backoff = 10l;
+
+		while (!bufferArena.acquire(slot, node))
+		{
+			if (backoff == 10)
+				log_warning(MinerLogger::plotReader, "Could not allocate a buffer of %s, waiting for free memory...",
+					memToString(bufferArena.getSlotSize(), 0));
+
+			// returns early, when the reader is cancelled
+			if (sleep(backoff))
+				return false;
+
+			backoff = std::min(backoff * 2, 1000l);
+		}
+
+		return true;
+	};
 
 	while (!isCancelled())
 	{
 		try
 		{
-			Poco::Notification::Ptr notification(plotReadQueue_->waitDequeueNotification());
-			PlotReadNotification::Ptr plotReadNotification;
+			// waits until the device of the next plot dir is not read by another reader
+			const auto plotReadNotification = plotReadScheduler_->waitDequeue();
 
-			if (notification)
-				plotReadNotification = notification.cast<PlotReadNotification>();
-			else
+			if (plotReadNotification.isNull())
 				break;
 
+			PlotReadDeviceLock deviceLock{*plotReadScheduler_, *plotReadNotification};
+
 			START_PROBE_DOMAIN("PlotReader.ReadDir", plotReadNotification->dir)
 
 			// only process the current block
@@ -118,6 +261,23 @@ void Burst::PlotReader::runTask()
 
 			// check, if the incoming plot-read-notification is for the current round
 			auto currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
+			const auto blockData = data_.getBlockData();
+
+			// a good enough deadline is already confirmed, the remaining nonces are not read,
+			// but counted as read and verified, so the round is finished
+			const auto isEarlyExit = [&]()
+			{
+				return currentBlock && blockData != nullptr && blockData->isEarlyExit();
+			};
+
+			const auto skipNonces = [&](const Poco::UInt64 nonces)
+			{
+				if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
+					progress_->add(nonces * Settings::PlotSize, plotReadNotification->blockheight);
+
+				if (progressVerify_ != nullptr)
+					progressVerify_->add(nonces * Settings::PlotSize, plotReadNotification->blockheight);
+			};
 			auto& plotList = plotReadNotification->plotList;
 
 			// put in all related plot files
@@ -127,23 +287,92 @@ void Burst::PlotReader::runTask()
 
 			for (auto plotFileIter = plotList.begin(); plotFileIter != plotList.end() && !isCancelled() && currentBlock; ++plotFileIter)
 			{
-				auto& plotFile = **plotFileIter;
-				std::ifstream inputStream(plotFile.getPath(), std::ifstream::in | std::ifstream::binary);
+				// after an early exit the remaining files are neither looked up in the cache nor opened
+				if (!plotReadNotification->wakeUpCall && isEarlyExit())
+				{
+					for (; plotFileIter != plotList.end(); ++plotFileIter)
+					{
+						skipNonces((*plotFileIter)->getNonces());
+
+						if (!MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
+							progress_->add((*plotFileIter)->getSize(), plotReadNotification->blockheight);
+					}
+
+					break;
+				}
+
+				// an optimized copy in the plot cache is read instead of the original file (but the HDD is woken up)
+				const auto cachedPlotFile = plotReadNotification->wakeUpCall ? nullptr :
+					PlotCache::instance().getCachedFile(**plotFileIter);
+				auto& plotFile = cachedPlotFile != nullptr ? *cachedPlotFile : **plotFileIter;
+				PlotFileHandle file(plotFile.getPath(), MinerConfig::getConfig().isDirectIo() && !plotReadNotification->wakeUpCall);
 
 				START_PROBE_DOMAIN("PlotReader.ReadFile", plotFile.getPath())
 				Poco::Timestamp timeStartFile;
+				auto skipped = false;
 
-				if (!isCancelled() && inputStream.is_open())
+				// is called when the request of a chunk is completed (with all of its segments)
+				const auto completeRequest = [&](PlotReadRequest& request)
+				{
+					auto& job = *static_cast<PlotReadJob*>(request.userData);
+
+					if (!request.success)
+						log_error(MinerLogger::plotReader, "Could not read %s from plot file %s (offset %Lu, error %d)",
+							memToString(request.getSize(), 2), plotFile.getPath(), request.segments.front().offset, request.error);
+
+					START_PROBE_DOMAIN("PlotReader.PushWork", plotFile.getPath());
+					currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
+
+					if (request.success && currentBlock && !isCancelled())
+					{
+						job.verification->buffer = PlotReadPlanner::assemble(job.plan, request.buffer);
+						job.verification->bufferSize = job.plan.nonces;
+
+						// in the fused mode the scoops are verified now, while they are still in the cache
+						const auto stop = [&]()
+						{
+							return isCancelled() || plotReadNotification->blockheight != data_.getCurrentBlockheight();
+						};
+
+						if (!fusedVerifier_->verify(*job.verification, stop))
+							verificationQueue_->enqueue(job.verification, job.verification->slot.node);
+					}
+					else
+					{
+						globalBufferSize.free(job.verification->memorySize);
+						bufferArena.release(job.verification->slot);
+
+						// a broken chunk is never verified, so count it as verified to let the round finish
+						if (!request.success && currentBlock && progressVerify_ != nullptr)
+							progressVerify_->add(job.plan.nonces * Settings::PlotSize, plotReadNotification->blockheight);
+					}
+
+					if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr && currentBlock)
+						progress_->add(job.plan.nonces * Settings::PlotSize, plotReadNotification->blockheight);
+
+					job.verification = nullptr;
+					freeJobs.emplace_back(&job);
+
+					TAKE_PROBE_DOMAIN("PlotReader.PushWork", plotFile.getPath());
+				};
+
+				const auto waitRequest = [&]()
+				{
+					START_PROBE_DOMAIN("PlotReader.WaitRead", plotFile.getPath());
+					const auto request = backend->waitCompletion();
+					TAKE_PROBE_DOMAIN("PlotReader.WaitRead", plotFile.getPath());
+
+					if (request != nullptr)
+						completeRequest(*request);
+				};
+
+				if (!isCancelled() && file.isOpen())
 				{
 					if (plotReadNotification->wakeUpCall)
 					{
 						// its just a wake up call for the HDD, simply read the first byte
 						char dummyByte;
-						//
-						inputStream.read(&dummyByte, 1);
-
-						// close the file ...
-						inputStream.close();
+						file.read(&dummyByte, 1, 0);
 
 						log_debug(MinerLogger::plotReader, "Woke up the HDD %s", plotReadNotification->dir);
 
@@ -151,154 +380,103 @@ void Burst::PlotReader::runTask()
 						break;
 					}
 
-					const auto maxBufferSize = MinerConfig::getConfig().getMaxBufferSize();
-					auto chunkBytes = maxBufferSize / MinerConfig::getConfig().getBufferChunkCount();
-
-					// unlimited buffer size
-					if (maxBufferSize == 0)
-						chunkBytes = plotFile.getStaggerScoopBytes();
-
-					const auto noncesPerChunk = std::min(chunkBytes / Settings::ScoopSize, plotFile.getStaggerSize());
+					// a plot file, that is converted in place, is PoC2 up to the converted nonces of the scoop
+					const auto poc2Nonces = plotFile.getPoC2Nonces(plotReadNotification->scoopNum);
 					auto nonce = 0ull;
 
-					while (nonce < plotFile.getNonces() && currentBlock && !isCancelled())
+					while (((nonce < plotFile.getNonces() && currentBlock) || backend->getPending() > 0) && !isCancelled())
 					{
-						START_PROBE_DOMAIN("PlotReader.Nonces", plotFile.getPath());
-						const auto startNonce = nonce;
-						auto readNonces = noncesPerChunk;
-						const auto staggerBegin = startNonce / plotFile.getStaggerSize();
-						const auto staggerEnd = (startNonce + readNonces) / plotFile.getStaggerSize();
+						if (nonce < plotFile.getNonces() && isEarlyExit())
+						{
+							skipNonces(plotFile.getNonces() - nonce);
+							skipped = nonce == 0;
+							nonce = plotFile.getNonces();
+							continue;
+						}
+
+						// as long as the queue is not full, we push new reads into it
+						if (nonce >= plotFile.getNonces() || !currentBlock || freeJobs.empty())
+						{
+							waitRequest();
+							continue;
+						}
 
-						if (staggerBegin != staggerEnd)
-							readNonces = plotFile.getStaggerSize() - startNonce % plotFile.getStaggerSize();
+						START_PROBE_DOMAIN("PlotReader.Nonces", plotFile.getPath());
+						auto& job = *freeJobs.back();
 
-						auto memoryAcquired = false;
-						auto memoryAcquiredMirror = false;
-						const auto memoryToAcquire = std::min(readNonces * Settings::ScoopSize, chunkBytes);
+						// every chunk occupies one slot of the arena
+						const auto memoryToAcquire = bufferArena.getSlotSize();
 
+						// our own reads in flight hold memory too, so we only sleep until memory is freed,
+						// when there is no own read, that we can hand over to the verifiers instead
 						START_PROBE_DOMAIN("PlotReader.AllocMemory", plotFile.getPath());
-						while (!isCancelled() && !memoryAcquired)
-						{
-							memoryAcquired = globalBufferSize.reserve(memoryToAcquire);
-
-							if ((poc2 && !plotFile.isPoC(2)) || (!poc2 && plotFile.isPoC(2)))
-								while (!isCancelled() && !memoryAcquiredMirror)
-									memoryAcquiredMirror = globalBufferSize.reserve(memoryToAcquire);
-						}
+						const auto memoryAcquired = backend->getPending() > 0 ? globalBufferSize.reserve(memoryToAcquire) :
+							globalBufferSize.reserve(memoryToAcquire, std::chrono::milliseconds{100});
 						TAKE_PROBE_DOMAIN("PlotReader.AllocMemory", plotFile.getPath());
 
-						// if the reader is cancelled, jump out of the loop
-						if (isCancelled())
+						if (!memoryAcquired)
 						{
-							// but first give free the allocated memory
-							if (memoryAcquired)
-								globalBufferSize.free(memoryToAcquire);
-
-							if (memoryAcquiredMirror)
-								globalBufferSize.free(memoryToAcquire);
+							if (backend->getPending() > 0)
+								waitRequest();
 
 							continue;
 						}
 
-						if (memoryAcquired && currentBlock)
+						START_PROBE("PlotReader.CreateVerification");
+						freeJobs.pop_back();
+
+						job.verification = new VerifyNotification{};
+						job.verification->accountId = plotFile.getAccountId();
+						job.verification->nonceStart = plotFile.getNonceStart();
+						job.verification->block = plotReadNotification->blockheight;
+						job.verification->inputPath = (*plotFileIter)->getPath();
+						job.verification->gensig = plotReadNotification->gensig;
+						job.verification->shabalMidstates = plotReadNotification->shabalMidstates;
+						job.verification->forkGensigs = plotReadNotification->forkGensigs;
+						job.verification->baseTarget = plotReadNotification->baseTarget;
+						job.verification->targetDeadline = plotReadNotification->targetDeadline;
+						job.verification->memorySize = memoryToAcquire;
+
+						if (!allocate(job.verification->slot))
 						{
-							START_PROBE_DOMAIN("PlotReader.PushWork", plotFile.getPath());
-							const auto chunkOffset = startNonce % plotFile.getStaggerSize() * Settings::ScoopSize;
-							const auto staggerBlockOffset = staggerBegin * plotFile.getStaggerBytes();
-							const auto staggerScoopOffset = plotReadNotification->scoopNum * plotFile.getStaggerScoopBytes();
-
-							START_PROBE("PlotReader.CreateVerification");
-							VerifyNotification::Ptr verification(new VerifyNotification{});
-							verification->accountId = plotFile.getAccountId();
-							verification->nonceStart = plotFile.getNonceStart();
-							verification->block = plotReadNotification->blockheight;
-							verification->inputPath = plotFile.getPath();
-							verification->gensig = plotReadNotification->gensig;
-							verification->nonceRead = startNonce;
-							verification->baseTarget = plotReadNotification->baseTarget;
-							verification->memorySize = memoryToAcquire;
-
-							memoryAcquired = false;
-
-							while (!memoryAcquired && !isCancelled())
-							{
-								try
-								{
-									verification->buffer.resize(readNonces);
-									memoryAcquired = true;
-								}
-								catch (std::bad_alloc&)
-								{
-								}
-								catch (...)
-								{
-									globalBufferSize.free(memoryToAcquire);
-									throw;
-								}
-							}
-
-							if (memoryAcquiredMirror)
-							{
-								memoryAcquiredMirror = false;
-
-								while (!memoryAcquiredMirror && !isCancelled())
-								{
-									try
-									{
-										bufferMirror.resize(readNonces);
-										memoryAcquiredMirror = true;
-									}
-									catch (std::bad_alloc&)
-									{
-									}
-									catch (...)
-									{
-										globalBufferSize.free(memoryToAcquire);
-										throw;
-									}
-								}
-							}
-							TAKE_PROBE("PlotReader.CreateVerification");
-
-							START_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
-							inputStream.seekg(staggerBlockOffset + staggerScoopOffset + chunkOffset);
-							inputStream.read(reinterpret_cast<char*>(&verification->buffer[0]), memoryToAcquire);
-
-							if (memoryAcquiredMirror)
-							{
-								const auto staggerScoopOffsetMirror = (4095 - plotReadNotification->scoopNum) * plotFile.getStaggerScoopBytes();
-								inputStream.seekg(staggerBlockOffset + staggerScoopOffsetMirror + chunkOffset);
-								inputStream.read(reinterpret_cast<char*>(&bufferMirror[0]), memoryToAcquire);
-
-								for (size_t i = 0; i < verification->buffer.size(); ++i)
-									memcpy(&verification->buffer[i][32], &bufferMirror[i][32], 32);
-
-								bufferMirror.clear();
-								globalBufferSize.free(memoryToAcquire);
-							}
-							TAKE_PROBE_DOMAIN("PlotReader.SeekAndRead", plotFile.getPath());
-
-							verificationQueue_->enqueueNotification(verification);
-
-							if (MinerConfig::getConfig().isSteadyProgressBar() && progress_ != nullptr)
-								progress_->add(readNonces * Settings::PlotSize, plotReadNotification->blockheight);
-
-							// check, if the incoming plot-read-notification is for the current round
-							currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
-							nonce += readNonces;
-
-							TAKE_PROBE_DOMAIN("PlotReader.PushWork", plotFile.getPath());
-						}
-						// if the memory was acquired, but it was not the right block, give it free
-						else if (memoryAcquired)
+							// the reader was cancelled while waiting for memory
 							globalBufferSize.free(memoryToAcquire);
-							// this should never happen.. no memory allocated, not cancelled, wrong block
-						else;
+							job.verification = nullptr;
+							freeJobs.emplace_back(&job);
+							continue;
+						}
+
+						TAKE_PROBE("PlotReader.CreateVerification");
+
+						// the slot is filled as much as possible, with the blocks of many staggers of an unoptimized plot file
+						const auto& slot = job.verification->slot;
+						const auto startNonce = nonce;
+						const auto plotPoC2 = startNonce < poc2Nonces;
+						const auto mirror = poc2 != plotPoC2;
+						auto readNonces = PlotReadPlanner::getChunkNonces(plotFile, startNonce, slot.size, mirror, file.isDirect());
+
+						// a chunk is either completely converted or not at all
+						if (plotPoC2)
+							readNonces = std::min<Poco::UInt64>(readNonces, poc2Nonces - startNonce);
+
+						job.verification->nonceRead = startNonce;
+						job.plan = PlotReadPlanner::plan(job.request, plotFile, plotReadNotification->scoopNum, startNonce, readNonces,
+							mirror, file.isDirect(), slot.size);
+
+						job.request.file = &file;
+						job.request.buffer = slot.data;
+						job.request.userData = &job;
+
+						backend->submit(job.request);
+
+						nonce += readNonces;
 						TAKE_PROBE_DOMAIN("PlotReader.Nonces", plotFile.getPath());
 					}
-				}
 
-				inputStream.close();
+					// the buffers of the reads in flight can not be given free before the reads are completed
+					while (backend->getPending() > 0)
+						waitRequest();
+				}
 
 				// check, if the incoming plot-read-notification is for the current round
 				currentBlock = plotReadNotification->blockheight == data_.getCurrentBlockheight();
@@ -324,7 +502,7 @@ void Burst::PlotReader::runTask()
 					const auto nonceBytes = static_cast<double>(plotFile.getNonces() * Settings::ScoopSize);
 					const auto bytesPerSeconds = nonceBytes / fileReadDiffSeconds;
 
-					log_information_if(MinerLogger::plotReader, MinerLogger::hasOutput(PlotDone), "%s (%s) read in %ss (~%s/s)",
+					log_information_if(MinerLogger::plotReader, MinerLogger::hasOutput(PlotDone) && !skipped, "%s (%s) read in %ss (~%s/s)",
 						plotFile.getPath(),
 						memToString(plotFile.getSize(), 2),
 						Poco::DateTimeFormatter::format(span, "%s.%i"),
@@ -340,7 +518,7 @@ void Burst::PlotReader::runTask()
 
 				// if it was cancelled, we push the current plot dir back in the queue again
 				if (isCancelled())
-					plotReadQueue_->enqueueNotification(plotReadNotification);
+					plotReadScheduler_->enqueue(plotReadNotification);
 
 				TAKE_PROBE_DOMAIN("PlotReader.ReadFile", plotFile.getPath());
 			}
@@ -348,8 +526,6 @@ void Burst::PlotReader::runTask()
 			if (plotReadNotification->wakeUpCall)
 				continue;
 
-			data_.getBlockData()->setProgress(plotReadNotification->dir, 100.f, plotReadNotification->blockheight);
-
 			const auto dirReadDiff = timeStartDir.elapsed();
 			const auto dirReadDiffSeconds = static_cast<float>(dirReadDiff) / 1000 / 1000;
 			const Poco::Timespan span{dirReadDiff};
@@ -359,6 +535,12 @@ void Burst::PlotReader::runTask()
 			for (const auto& plot : plotReadNotification->plotList)
 				totalSizeBytes += plot->getSize();
 
+			// only a completely read directory tells the real throughput
+			const auto completed = currentBlock && !isCancelled() && !isEarlyExit();
+
+			data_.getBlockData()->setProgress(plotReadNotification->dir, 100.f, plotReadNotification->blockheight,
+				completed ? totalSizeBytes / Settings::PlotSize * Settings::ScoopSize : 0, dirReadDiffSeconds);
+
 			if (plotReadNotification->type == PlotDir::Type::Sequential && totalSizeBytes > 0 && currentBlock)
 			{
 				const auto sumNonces = totalSizeBytes / Settings::PlotSize;
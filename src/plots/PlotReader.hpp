@@ -26,69 +26,148 @@
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
 #include "Declarations.hpp"
 #include <Poco/Task.h>
 #include <atomic>
 #include <Poco/Notification.h>
 #include "mining/MinerConfig.hpp"
 #include "Plot.hpp"
-
-namespace Poco
-{
-	class NotificationQueue;
-}
+#include "BufferArena.hpp"
 
 namespace Burst
 {
 	class MinerData;
 	class PlotReadProgress;
+	class PlotReadScheduler;
+	class VerificationQueue;
+	class ShabalMidstates;
+	class ForkGensigs;
 
+	/**
+	 * \brief The memory budget, that is shared by all plot readers.
+	 * Reserving and freeing is lock-free, only a reader that has to wait for memory sleeps on a condition.
+	 */
 	class GlobalBufferSize
 	{
 	public:
+		/**
+		 * \brief Sets the maximal size of the budget. 0 means unlimited.
+		 */
 		void setMax(Poco::UInt64 max);
+
+		/**
+		 * \brief Tries to reserve memory. Never blocks.
+		 * \param size The amount of bytes.
+		 * \return true, if the memory was reserved.
+		 */
 		bool reserve(Poco::UInt64 size);
+
+		/**
+		 * \brief Reserves memory and waits until there is enough memory free.
+		 * \param size The amount of bytes.
+		 * \param timeout The maximal time to wait.
+		 * \return true, if the memory was reserved, false if the timeout elapsed before.
+		 */
+		bool reserve(Poco::UInt64 size, std::chrono::milliseconds timeout);
+
 		void free(Poco::UInt64 size);
 		
 		Poco::UInt64 getSize() const;
 		Poco::UInt64 getMax() const;
 
+		/**
+		 * \brief Returns the time in microseconds, that readers waited for memory since the last reset.
+		 */
+		Poco::UInt64 getWaitTime() const;
+
+		/**
+		 * \brief Returns how often readers waited for memory since the last reset.
+		 */
+		Poco::UInt64 getWaitCount() const;
+
+		void resetWaitStatistics();
+
 	private:
-		Poco::UInt64 size_ = 0;
-		Poco::UInt64 max_ = 0;
-		mutable Poco::FastMutex mutex_;
+		std::atomic<Poco::UInt64> size_{0};
+		std::atomic<Poco::UInt64> max_{0};
+		std::atomic<Poco::UInt64> waitTime_{0};
+		std::atomic<Poco::UInt64> waitCount_{0};
+		std::atomic<unsigned> waiting_{0};
+		std::mutex mutex_;
+		std::condition_variable freed_;
 	};
 
 	struct PlotReadNotification : Poco::Notification
 	{
 		typedef Poco::AutoPtr<PlotReadNotification> Ptr;
 		std::string dir;
+		std::string device;
 		std::vector<std::shared_ptr<PlotFile>> plotList;
 		Poco::UInt64 scoopNum = 0;
 		GensigData gensig;
+		std::shared_ptr<const ShabalMidstates> shabalMidstates;
+		std::shared_ptr<ForkGensigs> forkGensigs;
 		Poco::UInt64 blockheight = 0;
 		Poco::UInt64 baseTarget = 0;
+		Poco::UInt64 targetDeadline = 0;
 		std::vector<std::pair<std::string, std::vector<std::shared_ptr<PlotFile>>>> relatedPlotLists;
 		PlotDir::Type type = PlotDir::Type::Sequential;
 		bool wakeUpCall = false;
 	};
 
+	struct VerifyNotification;
+
+	/**
+	 * \brief Lets the plot readers verify the scoops by themselves, right after they are read (fused mode).
+	 * The scoops do not wait inside the verification queue, where they get cold, but are hashed
+	 * by the reader in sub chunks, that fit into the L2 cache.
+	 */
+	class FusedVerifier
+	{
+	public:
+		using VerifyFunction = std::function<void(VerifyNotification&, const std::function<bool()>&)>;
+
+		/**
+		 * \brief Sets the function, that verifies a notification in the calling thread.
+		 * \param function The function or an empty function to deactivate the fused mode.
+		 */
+		void setFunction(VerifyFunction function);
+
+		/**
+		 * \brief Verifies a notification in the calling thread.
+		 * \param notification The notification, that was read.
+		 * \param stop Returns true, if the verification should be stopped.
+		 * \return false, if the fused mode is not active and the notification needs to be queued.
+		 */
+		bool verify(VerifyNotification& notification, const std::function<bool()>& stop) const;
+
+	private:
+		std::shared_ptr<VerifyFunction> function_;
+		mutable std::mutex mutex_;
+	};
+
 	class PlotReader : public Poco::Task
 	{
 	public:
-		PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progress,
-			Poco::NotificationQueue& verificationQueue, Poco::NotificationQueue& plotReadQueue);
+		PlotReader(MinerData& data, std::shared_ptr<PlotReadProgress> progressRead,
+			std::shared_ptr<PlotReadProgress> progressVerify, VerificationQueue& verificationQueue,
+			FusedVerifier& fusedVerifier, PlotReadScheduler& plotReadScheduler);
 		~PlotReader() override = default;
 
 		void runTask() override;
 
 		static GlobalBufferSize globalBufferSize;
+		static BufferArena bufferArena;
 
 	private:
 		MinerData& data_;
-		std::shared_ptr<PlotReadProgress> progress_;
-		Poco::NotificationQueue* verificationQueue_;
-		Poco::NotificationQueue* plotReadQueue_;
+		std::shared_ptr<PlotReadProgress> progress_, progressVerify_;
+		VerificationQueue* verificationQueue_;
+		FusedVerifier* fusedVerifier_;
+		PlotReadScheduler* plotReadScheduler_;
 	};
 
 	class PlotReadProgress
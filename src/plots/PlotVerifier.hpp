@@ -23,16 +23,24 @@
 
 #include <Poco/Task.h>
 #include <vector>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <cstring>
 #include "Declarations.hpp"
 #include <Poco/AutoPtr.h>
 #include <Poco/Notification.h>
-#include <Poco/NotificationQueue.h>
 #include "shabal/MinerShabal.hpp"
 #include "logging/Performance.hpp"
 #include "mining/Miner.hpp"
 #include "logging/Message.hpp"
 #include "logging/MinerLogger.hpp"
 #include "PlotReader.hpp"
+#include "VerificationQueue.hpp"
+#include "mining/Numa.hpp"
+#include "mining/ForkGensigs.hpp"
 #include "gpu/gpu_shell.hpp"
 #include "gpu/algorithm/gpu_algorithm_atomic.hpp"
 
@@ -40,42 +48,129 @@ namespace Burst
 {
 	class PlotReadProgress;
 
+	using DeadlineTuple = std::pair<Poco::UInt64, Poco::UInt64>;
+
 	struct VerifyNotification : Poco::Notification
 	{
 		typedef Poco::AutoPtr<VerifyNotification> Ptr;
 
-		std::vector<ScoopData> buffer;
+		~VerifyNotification() override
+		{
+			PlotReader::bufferArena.release(slot);
+		}
+
+		/**
+		 * \brief The slot of the buffer arena, the scoops are read into.
+		 */
+		BufferSlot slot;
+
+		/**
+		 * \brief The scoops inside the slot (can be behind the beginning, if the read was aligned).
+		 */
+		ScoopData* buffer = nullptr;
+		size_t bufferSize = 0;
 		Poco::UInt64 accountId = 0;
 		Poco::UInt64 nonceRead = 0;
 		Poco::UInt64 nonceStart = 0;
 		std::string inputPath = "";
 		Poco::UInt64 block = 0;
 		GensigData gensig;
+		std::shared_ptr<const ShabalMidstates> shabalMidstates;
+		/**
+		 * \brief The fork tips, that are verified with the same scoops (can be nullptr).
+		 */
+		std::shared_ptr<ForkGensigs> forkGensigs;
 		Poco::UInt64 baseTarget = 0;
+		/**
+		 * \brief Deadlines above this deadline are dropped by the verifiers (0 = no limit).
+		 */
+		Poco::UInt64 targetDeadline = 0;
 		Poco::UInt64 memorySize = 0;
+
+		/**
+		 * \brief Adds a part, the chunk was split into.
+		 * Must be called, before the part is visible to the other verifiers.
+		 */
+		void addPart()
+		{
+			++pendingParts_;
+		}
+
+		/**
+		 * \brief Adds the best {nonce->deadline} pair of a verified part.
+		 * \param result The pair of the part.
+		 * \return true, if it was the last part, then the chunk is completely verified.
+		 */
+		bool addResult(const DeadlineTuple& result)
+		{
+			{
+				std::lock_guard<std::mutex> lock{resultMutex_};
+
+				if (result.second != 0 && (bestResult_.second == 0 || result.second < bestResult_.second))
+					bestResult_ = result;
+			}
+
+			return --pendingParts_ == 0;
+		}
+
+		/**
+		 * \brief Returns the best {nonce->deadline} pair of all verified parts.
+		 */
+		DeadlineTuple getBestResult() const
+		{
+			std::lock_guard<std::mutex> lock{resultMutex_};
+			return bestResult_;
+		}
+
+	private:
+		std::atomic<size_t> pendingParts_{1};
+		DeadlineTuple bestResult_{0, 0};
+		mutable std::mutex resultMutex_;
 	};
-	
-	using DeadlineTuple = std::pair<Poco::UInt64, Poco::UInt64>;
+
 	using SubmitFunction = std::function<void(Poco::UInt64, Poco::UInt64, Poco::UInt64, Poco::UInt64, std::string, bool)>;
 
 	template <typename TVerificationAlgorithm>
 	class PlotVerifier : public Poco::Task
 	{
 	public:
-		PlotVerifier(MinerData& data, Poco::NotificationQueue& queue, std::shared_ptr<PlotReadProgress> progress,
+		PlotVerifier(MinerData& data, VerificationQueue& queue, std::shared_ptr<PlotReadProgress> progress,
 		             SubmitFunction submitFunction);
 		~PlotVerifier() override;
 		void runTask() override;
+
+		/**
+		 * \brief Searches the best deadline inside the scoops of a notification.
+		 * \param notification The notification with the scoops.
+		 * \param offset The first scoop, that is verified.
+		 * \param size The amount of scoops, that are verified.
+		 * \param stop Returns true, if the search should be stopped.
+		 * \param stream The stream of the verification algorithm.
+		 * \param subChunkSize The amount of scoops, that are verified at once (0 = all at once).
+		 * \return The best {nonce->deadline} pair or {0, 0}.
+		 */
+		static DeadlineTuple searchDeadline(const VerifyNotification& notification, size_t offset, size_t size,
+			const std::function<bool()>& stop, void* stream, size_t subChunkSize = 0);
+
+		/**
+		 * \brief Submits the best deadline of a verified notification and gives its memory free.
+		 * \param notification The verified notification.
+		 * \param bestResult The best {nonce->deadline} pair of the notification.
+		 * \param submitFunction The function, that submits the deadline.
+		 * \param progress The verification progress (can be nullptr).
+		 */
+		static void finish(VerifyNotification& notification, const DeadlineTuple& bestResult,
+			const SubmitFunction& submitFunction, PlotReadProgress* progress);
 		
 	private:
 		MinerData* data_;
-		Poco::NotificationQueue* queue_;
+		VerificationQueue* queue_;
 		std::shared_ptr<PlotReadProgress> progress_;
 		SubmitFunction submitFunction_;
 	};
 
 	template <typename TVerificationAlgorithm>
-	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, Poco::NotificationQueue& queue,
+	PlotVerifier<TVerificationAlgorithm>::PlotVerifier(MinerData& data, VerificationQueue& queue,
 		std::shared_ptr<PlotReadProgress> progress, SubmitFunction submitFunction)
 		: Task("PlotVerifier"), data_{&data}, queue_{&queue}, progress_{progress}, submitFunction_{submitFunction}
 	{
@@ -90,6 +185,10 @@ namespace Burst
 	void PlotVerifier<TVerificationAlgorithm>::runTask()
 	{
 		void* stream = nullptr;
+
+		// the chunks of the own NUMA node are verified first
+		const auto node = Numa::instance().pinThread(Numa::Pool::Verifier);
+		const auto worker = queue_->addWorker(node, TVerificationAlgorithm::SplitSize);
 		
 		if (!TVerificationAlgorithm::initStream(&stream))
 		{
@@ -102,44 +201,28 @@ namespace Burst
 		{
 			try
 			{
-				Poco::Notification::Ptr notification(queue_->waitDequeueNotification());
-				VerifyNotification::Ptr verifyNotification;
+				VerificationWork work;
 
-				if (notification)
-					verifyNotification = notification.cast<VerifyNotification>();
-				else
+				if (!queue_->waitDequeue(worker, work))
 					break;
 
+				auto& verifyNotification = *work.notification;
+
 				const auto stopFunction = [this, &verifyNotification]()
 				{
-					return isCancelled() || verifyNotification->block != data_->getCurrentBlockheight();
+					return isCancelled() || verifyNotification.block != data_->getCurrentBlockheight();
 				};
 
-				START_PROBE("PlotVerifier.SearchDeadline");
-				auto bestResult = TVerificationAlgorithm::run(verifyNotification->buffer, verifyNotification->nonceRead,
-					verifyNotification->nonceStart, verifyNotification->baseTarget, verifyNotification->gensig,
-					stopFunction, stream);
-				TAKE_PROBE("PlotVerifier.SearchDeadline");
-
-				if (bestResult.first != 0 && bestResult.second != 0)
-				{
-					START_PROBE("PlotVerifier.Submit");
-					submitFunction_(bestResult.first,
-					                verifyNotification->accountId,
-					                bestResult.second,
-					                verifyNotification->block,
-					                verifyNotification->inputPath,
-					                true);
-					TAKE_PROBE("PlotVerifier.Submit");
-				}
+				const auto startPoint = std::chrono::high_resolution_clock::now();
+				const auto result = searchDeadline(verifyNotification, work.offset, work.size, stopFunction, stream);
+				const std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - startPoint;
 
-				START_PROBE("PlotVerifier.FreeMemory");
-				PlotReader::globalBufferSize.free(verifyNotification->memorySize);
-				TAKE_PROBE("PlotVerifier.FreeMemory");
+				// the measured throughput decides, which verifier gets the next chunks
+				queue_->finishWork(worker, work, stopFunction() ? 0 : elapsed.count());
 
-				if (progress_ != nullptr)
-					progress_->add(static_cast<Poco::UInt64>(verifyNotification->buffer.size()) * Settings::PlotSize,
-						verifyNotification->block);
+				// the verifier of the last part submits the best deadline of the whole chunk
+				if (verifyNotification.addResult(result))
+					finish(verifyNotification, verifyNotification.getBestResult(), submitFunction_, progress_.get());
 			}
 			catch (Poco::Exception& exc)
 			{
@@ -160,6 +243,81 @@ namespace Burst
 		log_debug(MinerLogger::plotVerifier, "Verifier stopped");
 	}
 
+	template <typename TVerificationAlgorithm>
+	DeadlineTuple PlotVerifier<TVerificationAlgorithm>::searchDeadline(const VerifyNotification& notification,
+		const size_t offset, const size_t size, const std::function<bool()>& stop, void* stream, size_t subChunkSize)
+	{
+		DeadlineTuple bestResult{0, 0};
+		const auto end = std::min(offset + size, notification.bufferSize);
+
+		// the fork tips, that were added until now
+		const auto forks = notification.forkGensigs != nullptr ? notification.forkGensigs->getForks() : nullptr;
+		std::array<DeadlineTuple, ForkGensigs::MaxForks> forkResults;
+
+		if (subChunkSize == 0)
+			subChunkSize = size;
+
+		START_PROBE("PlotVerifier.SearchDeadline");
+		for (auto subOffset = offset; subOffset < end && !stop(); subOffset += subChunkSize)
+		{
+			DeadlineTuple result;
+
+			if (forks == nullptr || forks->empty())
+				result = TVerificationAlgorithm::run(notification.buffer + subOffset,
+					std::min(subChunkSize, end - subOffset),
+					notification.nonceRead + subOffset,
+					notification.nonceStart, notification.baseTarget, notification.targetDeadline,
+					notification.gensig,
+					notification.shabalMidstates.get(), stop, stream);
+			else
+			{
+				result = TVerificationAlgorithm::runForks(notification.buffer + subOffset,
+					std::min(subChunkSize, end - subOffset),
+					notification.nonceRead + subOffset,
+					notification.nonceStart, notification.baseTarget, notification.targetDeadline,
+					notification.gensig,
+					notification.shabalMidstates.get(), *forks, stop, stream, forkResults.data());
+
+				for (size_t i = 0; i < std::min(forks->size(), ForkGensigs::MaxForks); ++i)
+					if (forkResults[i].second != 0)
+						notification.forkGensigs->addResult(i, forkResults[i].first, forkResults[i].second,
+							notification.accountId, notification.inputPath);
+			}
+
+			if (result.second != 0 && (bestResult.second == 0 || result.second < bestResult.second))
+				bestResult = result;
+		}
+		TAKE_PROBE("PlotVerifier.SearchDeadline");
+
+		return bestResult;
+	}
+
+	template <typename TVerificationAlgorithm>
+	void PlotVerifier<TVerificationAlgorithm>::finish(VerifyNotification& notification, const DeadlineTuple& bestResult,
+		const SubmitFunction& submitFunction, PlotReadProgress* progress)
+	{
+		if (bestResult.first != 0 && bestResult.second != 0)
+		{
+			START_PROBE("PlotVerifier.Submit");
+			submitFunction(bestResult.first,
+			               notification.accountId,
+			               bestResult.second,
+			               notification.block,
+			               notification.inputPath,
+			               true);
+			TAKE_PROBE("PlotVerifier.Submit");
+		}
+
+		START_PROBE("PlotVerifier.FreeMemory");
+		PlotReader::bufferArena.release(notification.slot);
+		PlotReader::globalBufferSize.free(notification.memorySize);
+		TAKE_PROBE("PlotVerifier.FreeMemory");
+
+		if (progress != nullptr)
+			progress->add(static_cast<Poco::UInt64>(notification.bufferSize) * Settings::PlotSize,
+				notification.block);
+	}
+
 	template <typename TShabal>
 	struct PlotVerifierOperations_1
 	{
@@ -210,49 +368,151 @@ namespace Burst
 		}
 	};
 
+	template <typename TShabal>
+	struct PlotVerifierOperations_16
+	{
+		template <typename TContainer>
+		static void updateScoops(TShabal& shabal, const TContainer& scoopPtr)
+		{
+			shabal.update(scoopPtr[0], scoopPtr[1], scoopPtr[2], scoopPtr[3],
+				scoopPtr[4], scoopPtr[5], scoopPtr[6], scoopPtr[7],
+				scoopPtr[8], scoopPtr[9], scoopPtr[10], scoopPtr[11],
+				scoopPtr[12], scoopPtr[13], scoopPtr[14], scoopPtr[15], Burst::Settings::ScoopSize);
+		}
+
+		template <typename TContainer>
+		static void close(TShabal& shabal, TContainer& targetPtr)
+		{
+			shabal.close(targetPtr[0], targetPtr[1], targetPtr[2], targetPtr[3],
+				targetPtr[4], targetPtr[5], targetPtr[6], targetPtr[7],
+				targetPtr[8], targetPtr[9], targetPtr[10], targetPtr[11],
+				targetPtr[12], targetPtr[13], targetPtr[14], targetPtr[15]);
+		}
+	};
+
 	template <typename TShabal, typename TShabalOperations>
 	struct PlotVerifierAlgorithm_cpu
 	{
+		/**
+		 * \brief The amount of scoops, that are verified at once.
+		 */
+		static constexpr size_t SplitSize = VerificationQueue::DefaultSplitSize;
+
 		static bool initStream(void** stream)
 		{
 			return true;
 		}
 
-		static DeadlineTuple run(std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
-						Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, const GensigData& gensig,
-						std::function<bool()> stop, void* stream)
+		static DeadlineTuple run(const ScoopData* buffer, size_t bufferSize, Poco::UInt64 nonceRead,
+						Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, Poco::UInt64 targetDeadline,
+						const GensigData& gensig, const ShabalMidstates* midstates, std::function<bool()> stop, void* stream)
 		{
-			DeadlineTuple bestResult = {0, 0};
-			TShabal shabal;
+			const auto hashLimit = getHashLimit(baseTarget, targetDeadline);
+
+			// start from the context, that already hashed the gensig of the block;
+			// only if there is none, hash the gensig according to the cpu instruction level
+			if (midstates == nullptr)
+			{
+				const ShabalMidstates ownMidstates{gensig};
+				return verify(ownMidstates.get<TShabal>(), buffer, bufferSize, nonceRead, nonceStart, baseTarget, hashLimit, stop);
+			}
+
+			return verify(midstates->get<TShabal>(), buffer, bufferSize, nonceRead, nonceStart, baseTarget, hashLimit, stop);
+		}
 
-			// hash the gensig according to the cpu instruction level
-			shabal.update(gensig.data(), Settings::HashSize);
+		/**
+		 * \brief Verifies the scoops of a buffer against the gensig of the block and the gensigs of fork tips.
+		 * Every scoop is hashed once per gensig, while it is still in the cache.
+		 * \param forks The fork tips (only the first ForkGensigs::MaxForks are verified).
+		 * \param forkResults Receives the best {nonce->deadline} pair of every fork tip.
+		 * \return The best pair for the gensig of the block.
+		 */
+		static DeadlineTuple runForks(const ScoopData* buffer, size_t bufferSize, Poco::UInt64 nonceRead,
+						Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, Poco::UInt64 targetDeadline,
+						const GensigData& gensig, const ShabalMidstates* midstates, const ForkGensigs::Forks& forks,
+						std::function<bool()> stop, void* stream, DeadlineTuple* forkResults)
+		{
+			const auto hashLimit = getHashLimit(baseTarget, targetDeadline);
+			const auto count = std::min(forks.size(), ForkGensigs::MaxForks) + 1;
+			std::unique_ptr<ShabalMidstates> ownMidstates;
+			std::array<const TShabal*, ForkGensigs::MaxForks + 1> states;
+			std::array<DeadlineTuple, ForkGensigs::MaxForks + 1> results;
 
-			for (size_t i = 0;
-				i < buffer.size() && !stop();
-				i += TShabal::HashSize)
+			if (midstates == nullptr)
 			{
-				auto result = verify(shabal, buffer, nonceRead, nonceStart, i, baseTarget);
-
-				for (auto& pair : result)
-					// make sure the nonce->deadline pair is valid...
-					if (pair.first > 0 && pair.second > 0)
-						// ..and better than the others
-						if (bestResult.second == 0 || pair.second < bestResult.second)
-							bestResult = pair;
+				ownMidstates = std::make_unique<ShabalMidstates>(gensig);
+				midstates = ownMidstates.get();
 			}
 
-			return bestResult;
+			states[0] = &midstates->get<TShabal>();
+
+			for (size_t i = 1; i < count; ++i)
+				states[i] = &forks[i - 1].shabalMidstates->get<TShabal>();
+
+			verifyMulti(states.data(), count, buffer, bufferSize, nonceRead, nonceStart, baseTarget, hashLimit, stop,
+				results.data());
+
+			std::copy(results.begin() + 1, results.begin() + count, forkResults);
+			return results[0];
+		}
+
+		/**
+		 * \brief Returns the smallest hash, whose deadline is above the target deadline.
+		 * The deadline of a hash is hash / baseTarget, so comparing the hashes against this limit
+		 * is the same as comparing the deadlines against the target deadline.
+		 * \param baseTarget The base target of the block.
+		 * \param targetDeadline The target deadline or 0, if there is none.
+		 * \return The limit (saturated to the biggest hash).
+		 */
+		static Poco::UInt64 getHashLimit(Poco::UInt64 baseTarget, Poco::UInt64 targetDeadline)
+		{
+			constexpr auto maxHash = std::numeric_limits<Poco::UInt64>::max();
+
+			if (targetDeadline == 0 || targetDeadline >= maxHash / baseTarget)
+				return maxHash;
+
+			return (targetDeadline + 1) * baseTarget;
 		}
 
-		static std::vector<DeadlineTuple> verify(const TShabal& shabalCopy, std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
-										  Poco::UInt64 nonceStart, size_t offset, Poco::UInt64 baseTarget)
+		/**
+		 * \brief Verifies all scoops of a buffer and returns the best {nonce->deadline} pair.
+		 * \param midstate The context, that already hashed the gensig.
+		 * \param hashLimit Only hashes below this limit are taken (see getHashLimit).
+		 * \return The best pair or {0, 0}, if no deadline was found.
+		 */
+		static DeadlineTuple verify(const TShabal& midstate, const ScoopData* buffer, size_t bufferSize,
+									Poco::UInt64 nonceRead, Poco::UInt64 nonceStart, Poco::UInt64 baseTarget,
+									Poco::UInt64 hashLimit, const std::function<bool()>& stop)
+		{
+			const auto state = &midstate;
+			DeadlineTuple result;
+			verifyMulti(&state, 1, buffer, bufferSize, nonceRead, nonceStart, baseTarget, hashLimit, stop, &result);
+			return result;
+		}
+
+		/**
+		 * \brief Verifies all scoops of a buffer against one or more gensigs.
+		 * The scoops are hashed in batches of TShabal::HashSize lanes. All lane arrays live on the stack
+		 * and only the best pairs are kept, so the whole verification does not allocate memory.
+		 * Because the deadline grows with the hash, only the smallest hash is tracked and the
+		 * (expensive) division by the base target is done once for the best nonce.
+		 * \param midstates The contexts, that already hashed the gensigs.
+		 * \param count The amount of gensigs (at most ForkGensigs::MaxForks + 1).
+		 * \param hashLimit Only hashes below this limit are taken (see getHashLimit).
+		 * \param results Receives the best pair of every gensig or {0, 0}, if no deadline was found.
+		 */
+		static void verifyMulti(const TShabal* const* midstates, size_t count, const ScoopData* buffer, size_t bufferSize,
+								Poco::UInt64 nonceRead, Poco::UInt64 nonceStart, Poco::UInt64 baseTarget,
+								Poco::UInt64 hashLimit, const std::function<bool()>& stop, DeadlineTuple* results)
 		{
 			constexpr auto HashSize = TShabal::HashSize;
-			TShabal shabal = shabalCopy;
 
+			std::array<Poco::UInt64, ForkGensigs::MaxForks + 1> bestHashes;
+			std::array<Poco::UInt64, ForkGensigs::MaxForks + 1> bestNonces;
 			std::array<HashData, HashSize> targets;
-			std::array<Poco::UInt64, HashSize> results;
+
+			bestHashes.fill(hashLimit);
+			bestNonces.fill(0);
 
 			// these are the buffer overflow prove arrays 
 			// instead of directly working with the raw arrays  
@@ -260,81 +520,148 @@ namespace Burst
 			std::array<const unsigned char*, HashSize> scoopPtr;
 			std::array<unsigned char*, HashSize> targetPtr;
 
-			// we init the buffer overflow guardians
-			for (size_t i = 0; i < HashSize; ++i)
+			for (size_t offset = 0; offset < bufferSize && !stop(); offset += HashSize)
 			{
-				const auto overflow = i + offset >= buffer.size();
+				const auto lanes = std::min<size_t>(HashSize, bufferSize - offset);
 
-				// if the index would cause a buffer overflow, we init it 
-				// with a nullptr, otherwise with the value
-				scoopPtr[i] = overflow ? nullptr : reinterpret_cast<unsigned char*>(buffer.data() + offset + i);
-				targetPtr[i] = overflow ? nullptr : reinterpret_cast<unsigned char*>(targets[i].data());
-			}
-
-			// hash the scoop according to the cpu instruction level
-			TShabalOperations::updateScoops(shabal, scoopPtr);
-
-			// digest the hash
-			TShabalOperations::close(shabal, targetPtr);
-
-			for (auto i = 0u; i < HashSize; ++i)
-				memcpy(&results[i], targets[i].data(), sizeof(Poco::UInt64));
-
-			// for every calculated deadline we create a pair of {nonce->deadline}
-			std::vector<DeadlineTuple> pairs(HashSize);
+				// if the index would cause a buffer overflow, the lane gets a nullptr
+				for (size_t i = 0; i < HashSize; ++i)
+				{
+					scoopPtr[i] = i < lanes ? reinterpret_cast<const unsigned char*>(buffer + offset + i) : nullptr;
+					targetPtr[i] = i < lanes ? reinterpret_cast<unsigned char*>(targets[i].data()) : nullptr;
+				}
 
-			for (size_t i = 0u; i < HashSize; ++i)
-				// only set the pair if it was calculated
-				if (i + offset < buffer.size())
-					pairs[i] = std::make_pair(nonceStart + nonceRead + offset + i, results[i] / baseTarget);
+				for (size_t g = 0; g < count; ++g)
+				{
+					TShabal shabal = *midstates[g];
+
+					// hash the scoop according to the cpu instruction level
+					TShabalOperations::updateScoops(shabal, scoopPtr);
+
+					// digest the hash
+					TShabalOperations::close(shabal, targetPtr);
+
+					for (size_t i = 0; i < lanes; ++i)
+					{
+						Poco::UInt64 result;
+						memcpy(&result, targets[i].data(), sizeof(Poco::UInt64));
+
+						// make sure the deadline is valid (> 0) and better than the others
+						if (result >= baseTarget && result < bestHashes[g])
+						{
+							bestHashes[g] = result;
+							bestNonces[g] = nonceStart + nonceRead + offset + i;
+						}
+					}
+				}
+			}
 
-			return pairs;
+			for (size_t g = 0; g < count; ++g)
+				results[g] = bestHashes[g] == hashLimit
+					? DeadlineTuple{0, 0}
+					: std::make_pair(bestNonces[g], bestHashes[g] / baseTarget);
 		}
 	};
 
 	template <typename TGpu, typename TAlgorithm>
 	struct PlotVerifierAlgorithm_gpu
 	{
+		/**
+		 * \brief The GPU verifies whole chunks, because every run has a fixed overhead.
+		 */
+		static constexpr size_t SplitSize = 0;
+
 		static bool initStream(void** stream)
 		{
 			return TGpu::initStream(stream);
 		}
 
-		static DeadlineTuple run(std::vector<ScoopData>& buffer, Poco::UInt64 nonceRead,
-			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, const GensigData& gensig,
-			std::function<bool()> stop, void* stream)
+		static DeadlineTuple run(const ScoopData* buffer, size_t bufferSize, Poco::UInt64 nonceRead,
+			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, Poco::UInt64 targetDeadline,
+			const GensigData& gensig, const ShabalMidstates* midstates, std::function<bool()> stop, void* stream)
 		{
 			DeadlineTuple bestDeadline{0, 0};
 			TGpu::template run<TAlgorithm>(
 				buffer,
+				bufferSize,
 				gensig,
 				nonceStart + nonceRead,
 				baseTarget,
 				stream,
 				bestDeadline);
+
+			if (targetDeadline > 0 && bestDeadline.second > targetDeadline)
+				return {0, 0};
+
 			return bestDeadline;
 		}
+
+		/**
+		 * \brief Verifies the scoops of a buffer against the gensig of the block and the gensigs of fork tips.
+		 * The scoops are uploaded to the GPU only once and then verified against every gensig.
+		 */
+		static DeadlineTuple runForks(const ScoopData* buffer, size_t bufferSize, Poco::UInt64 nonceRead,
+			Poco::UInt64 nonceStart, Poco::UInt64 baseTarget, Poco::UInt64 targetDeadline,
+			const GensigData& gensig, const ShabalMidstates* midstates, const ForkGensigs::Forks& forks,
+			std::function<bool()> stop, void* stream, DeadlineTuple* forkResults)
+		{
+			const auto count = std::min(forks.size(), ForkGensigs::MaxForks);
+			std::array<const GensigData*, ForkGensigs::MaxForks + 1> gensigs;
+			std::array<DeadlineTuple, ForkGensigs::MaxForks + 1> bestDeadlines;
+
+			// the gensig of the block is the first one, the fork tips follow
+			gensigs[0] = &gensig;
+
+			for (size_t i = 0; i < count; ++i)
+				gensigs[i + 1] = &forks[i].gensig;
+
+			bestDeadlines.fill({0, 0});
+
+			TGpu::template runForks<TAlgorithm>(
+				buffer,
+				bufferSize,
+				gensigs.data(),
+				count + 1,
+				nonceStart + nonceRead,
+				baseTarget,
+				stream,
+				bestDeadlines.data());
+
+			for (auto& bestDeadline : bestDeadlines)
+				if (targetDeadline > 0 && bestDeadline.second > targetDeadline)
+					bestDeadline = {0, 0};
+
+			for (size_t i = 0; i < count; ++i)
+				forkResults[i] = bestDeadlines[i + 1];
+
+			return bestDeadlines[0];
+		}
 	};
 
 	using PlotVerifierOperation_sse2 = PlotVerifierOperations_1<Shabal256_SSE2>;
 	using PlotVerifierOperation_sse4 = PlotVerifierOperations_4<Shabal256_SSE4>;
 	using PlotVerifierOperation_avx = PlotVerifierOperations_4<Shabal256_AVX>;
 	using PlotVerifierOperation_avx2 = PlotVerifierOperations_8<Shabal256_AVX2>;
+	using PlotVerifierOperation_avx512 = PlotVerifierOperations_16<Shabal256_AVX512>;
 
 	using PlotVerifierAlgorithm_sse2 = PlotVerifierAlgorithm_cpu<Shabal256_SSE2, PlotVerifierOperation_sse2>;
 	using PlotVerifierAlgorithm_sse4 = PlotVerifierAlgorithm_cpu<Shabal256_SSE4, PlotVerifierOperation_sse4>;
 	using PlotVerifierAlgorithm_avx = PlotVerifierAlgorithm_cpu<Shabal256_AVX, PlotVerifierOperation_avx>;
 	using PlotVerifierAlgorithm_avx2 = PlotVerifierAlgorithm_cpu<Shabal256_AVX2, PlotVerifierOperation_avx2>;
+	using PlotVerifierAlgorithm_avx512 = PlotVerifierAlgorithm_cpu<Shabal256_AVX512, PlotVerifierOperation_avx512>;
 
 	using PlotVerifier_sse2 = PlotVerifier<PlotVerifierAlgorithm_sse2>;
 	using PlotVerifier_sse4 = PlotVerifier<PlotVerifierAlgorithm_sse4>;
 	using PlotVerifier_avx = PlotVerifier<PlotVerifierAlgorithm_avx>;
 	using PlotVerifier_avx2 = PlotVerifier<PlotVerifierAlgorithm_avx2>;
+	using PlotVerifier_avx512 = PlotVerifier<PlotVerifierAlgorithm_avx512>;
 
 	using PlotVerifierAlgorithm_cuda = PlotVerifierAlgorithm_gpu<GpuCuda, Gpu_Algorithm_Atomic>;
 	using PlotVerifierAlgorithm_opencl = PlotVerifierAlgorithm_gpu<GpuOpenCL, Gpu_Algorithm_Atomic>;
+	using PlotVerifierAlgorithm_simulatedGpu = PlotVerifierAlgorithm_gpu<GpuSimulated, Gpu_Algorithm_Atomic>;
 
 	using PlotVerifier_cuda = PlotVerifier<PlotVerifierAlgorithm_cuda>;
 	using PlotVerifier_opencl = PlotVerifier<PlotVerifierAlgorithm_opencl>;
+	using PlotVerifier_simulatedGpu = PlotVerifier<PlotVerifierAlgorithm_simulatedGpu>;
 }
 
@@ -0,0 +1,387 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "PlotWriter.hpp"
+#include "PlotGenerator.hpp"
+#include "PlotReadBackend.hpp"
+#include "VerifierBenchmark.hpp"
+#include "logging/MinerLogger.hpp"
+#include "MinerUtil.hpp"
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+constexpr Poco::UInt64 Burst::PlotWriter::NonceAlignment;
+
+namespace Burst
+{
+	namespace PlotWriterHelper
+	{
+		/**
+		 * \brief The amount of nonces, that a generator thread takes at once.
+		 * It is a multiple of the nonces of every kernel, so no generated nonce is thrown away inside a staging buffer.
+		 */
+		const Poco::UInt64 BatchSize = 16;
+
+		/**
+		 * \brief Copies a nonce in the PoC1 layout into a scoop-major buffer in the PoC2 layout.
+		 * The second hash of every PoC2 scoop is the second hash of the mirrored PoC1 scoop.
+		 */
+		void stageNonce(const char* nonceData, char* staging, const Poco::UInt64 index, const Poco::UInt64 nonces)
+		{
+			for (size_t scoop = 0; scoop < Settings::ScoopPerPlot; ++scoop)
+			{
+				const auto destination = staging + (scoop * nonces + index) * Settings::ScoopSize;
+				const auto mirror = Settings::ScoopPerPlot - 1 - scoop;
+
+				memcpy(destination, nonceData + scoop * Settings::ScoopSize, Settings::HashSize);
+				memcpy(destination + Settings::HashSize, nonceData + mirror * Settings::ScoopSize + Settings::HashSize,
+					Settings::HashSize);
+			}
+		}
+
+		/**
+		 * \brief Threads, that generate the nonces of one staging buffer together.
+		 */
+		class GeneratorPool
+		{
+		public:
+			GeneratorPool(const size_t threads, std::string instructionSet, const Poco::UInt64 account)
+				: instructionSet_{std::move(instructionSet)},
+				  account_{account}
+			{
+				for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i)
+					workers_.emplace_back(&GeneratorPool::work, this);
+			}
+
+			~GeneratorPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock{mutex_};
+					stop_ = true;
+				}
+
+				jobCondition_.notify_all();
+
+				for (auto& worker : workers_)
+					worker.join();
+			}
+
+			/**
+			 * \brief Generates consecutive nonces into a staging buffer and waits until all of them are staged.
+			 */
+			void generate(const Poco::UInt64 startNonce, const Poco::UInt64 nonces, char* staging)
+			{
+				std::unique_lock<std::mutex> lock{mutex_};
+				startNonce_ = startNonce;
+				nonces_ = nonces;
+				staging_ = staging;
+				next_ = 0;
+				busy_ = workers_.size();
+				++job_;
+				jobCondition_.notify_all();
+				doneCondition_.wait(lock, [this]() { return busy_ == 0; });
+			}
+
+		private:
+			void work()
+			{
+				Poco::UInt64 job = 0;
+
+				while (true)
+				{
+					{
+						std::unique_lock<std::mutex> lock{mutex_};
+						jobCondition_.wait(lock, [this, job]() { return stop_ || job_ != job; });
+
+						if (stop_)
+							return;
+
+						job = job_;
+					}
+
+					for (auto batch = next_.fetch_add(BatchSize); batch < nonces_; batch = next_.fetch_add(BatchSize))
+					{
+						const auto batchEnd = std::min(batch + BatchSize, nonces_);
+						auto index = batch;
+
+						while (index < batchEnd)
+							for (const auto& nonceData : PlotGenerator::generateNonces(instructionSet_, account_, startNonce_ + index))
+							{
+								if (index < batchEnd)
+									stageNonce(nonceData.data(), staging_, index, nonces_);
+
+								++index;
+							}
+					}
+
+					std::lock_guard<std::mutex> lock{mutex_};
+
+					if (--busy_ == 0)
+						doneCondition_.notify_one();
+				}
+			}
+
+			std::string instructionSet_;
+			Poco::UInt64 account_;
+			std::vector<std::thread> workers_;
+			std::mutex mutex_;
+			std::condition_variable jobCondition_, doneCondition_;
+			Poco::UInt64 job_ = 0, startNonce_ = 0, nonces_ = 0;
+			char* staging_ = nullptr;
+			std::atomic<Poco::UInt64> next_{0};
+			size_t busy_ = 0;
+			bool stop_ = false;
+		};
+	}
+}
+
+Burst::PlotWriter::PlotWriter(const std::string& dir, const Poco::UInt64 account, const Poco::UInt64 startNonce,
+	const Poco::UInt64 nonces)
+	: account_{account},
+	  startNonce_{startNonce},
+	  nonces_{nonces}
+{
+	Poco::Path path{dir};
+	path.makeDirectory();
+	path.setFileName(getFileName(account, startNonce, nonces));
+	path_ = path.toString();
+}
+
+void Burst::PlotWriter::setThreads(const size_t threads)
+{
+	threads_ = threads;
+}
+
+void Burst::PlotWriter::setInstructionSet(const std::string& instructionSet)
+{
+	instructionSet_ = instructionSet;
+}
+
+void Burst::PlotWriter::setMaxMemory(const Poco::UInt64 maxMemory)
+{
+	maxMemory_ = maxMemory;
+}
+
+void Burst::PlotWriter::setDirect(const bool direct)
+{
+	direct_ = direct;
+}
+
+bool Burst::PlotWriter::run()
+{
+	using namespace PlotWriterHelper;
+
+	const auto fileSize = nonces_ * Settings::PlotSize;
+	Poco::UInt64 noncesWritten = 0;
+
+	if (Poco::File{path_}.exists())
+	{
+		if (readProgress(noncesWritten) && noncesWritten <= nonces_)
+			log_system(MinerLogger::general, "Resuming the plot file %s at nonce %s", path_, numberToString(noncesWritten));
+		else if (Poco::File{path_}.getSize() == fileSize)
+		{
+			log_system(MinerLogger::general, "The plot file %s is already complete", path_);
+			noncesWritten_ = nonces_;
+			return true;
+		}
+		else
+			noncesWritten = 0;
+	}
+
+	// the progress is written before the file gets its size, so an interrupted file never looks complete
+	if (!writeProgress(noncesWritten))
+	{
+		log_error(MinerLogger::general, "Could not write the progress of the plot file %s", path_);
+		return false;
+	}
+
+	const PlotFileHandle file{path_, direct_ && nonces_ % NonceAlignment == 0, true};
+
+	if (!file.isOpen() || !file.resize(fileSize))
+	{
+		log_error(MinerLogger::general, "Could not create the plot file %s (%s)", path_, memToString(fileSize, 2));
+		return false;
+	}
+
+	auto instructionSet = instructionSet_;
+
+	// the generator of an instruction set, that the CPU does not support, would crash the plotter
+	if (instructionSet != "AUTO" && !VerifierBenchmark::isAvailable(instructionSet))
+	{
+		log_warning(MinerLogger::general, "The CPU instruction set %s is not supported by your CPU or the plotter is compiled without it!\n"
+			"The fastest available instruction set is used instead.", instructionSet);
+		instructionSet = "AUTO";
+	}
+
+	if (instructionSet == "AUTO")
+		instructionSet = VerifierBenchmark::findFastestInstructionSet();
+
+	const auto threads = threads_ == 0 ? std::max(std::thread::hardware_concurrency(), 1u) : threads_;
+
+	// two staging buffers, one is generated while the other one is written
+	auto groupSize = maxMemory_ / 2 / Settings::PlotSize / NonceAlignment * NonceAlignment;
+	groupSize = std::max(groupSize, NonceAlignment);
+	groupSize = std::min(groupSize, (nonces_ + NonceAlignment - 1) / NonceAlignment * NonceAlignment);
+
+	std::array<std::unique_ptr<AlignedBuffer>, 2> staging;
+
+	for (auto& buffer : staging)
+		buffer = std::make_unique<AlignedBuffer>(groupSize * Settings::PlotSize);
+
+	log_system(MinerLogger::general, "Plotting %s\n"
+		"\tnonces:          %s\n"
+		"\tinstruction set: %s\n"
+		"\tthreads:         %z\n"
+		"\tstaging buffers: 2 x %s\n"
+		"\tdirect writes:   %s",
+		path_, numberToString(nonces_), instructionSet, static_cast<size_t>(threads),
+		memToString(groupSize * Settings::PlotSize, 2), std::string(file.isDirect() ? "yes" : "no"));
+
+	GeneratorPool pool{threads, instructionSet, account_};
+	std::future<bool> pendingWrite;
+	noncesWritten_ = noncesWritten;
+	cancelled_ = false;
+
+	const auto startPoint = std::chrono::steady_clock::now();
+	size_t index = 0;
+
+	for (auto group = noncesWritten; group < nonces_ && !cancelled_; group += groupSize, ++index)
+	{
+		const auto groupNonces = std::min(groupSize, nonces_ - group);
+		const auto buffer = staging[index % 2]->data();
+
+		pool.generate(startNonce_ + group, groupNonces, buffer);
+
+		if (pendingWrite.valid() && !pendingWrite.get())
+			return false;
+
+		pendingWrite = std::async(std::launch::async, [this, &file, buffer, group, groupNonces, noncesWritten, startPoint]()
+		{
+			if (!writeGroup(file, buffer, group, groupNonces) || !file.sync() || !writeProgress(group + groupNonces))
+			{
+				log_error(MinerLogger::general, "Could not write into the plot file %s", path_);
+				return false;
+			}
+
+			noncesWritten_ = group + groupNonces;
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startPoint;
+			const auto noncesPerMinute = (group + groupNonces - noncesWritten) / elapsed.count() * 60;
+
+			log_information(MinerLogger::general, "Plotted %s/%s nonces (%s nonces/min)",
+				numberToString(group + groupNonces), numberToString(nonces_),
+				numberToString(static_cast<Poco::UInt64>(noncesPerMinute)));
+
+			return true;
+		});
+	}
+
+	if (pendingWrite.valid() && !pendingWrite.get())
+		return false;
+
+	if (cancelled_ && noncesWritten_ < nonces_)
+	{
+		log_system(MinerLogger::general, "Plotting of %s stopped at nonce %s", path_, numberToString(noncesWritten_.load()));
+		return false;
+	}
+
+	removeProgress();
+	log_success(MinerLogger::general, "The plot file %s is complete", path_);
+	return true;
+}
+
+void Burst::PlotWriter::cancel()
+{
+	cancelled_ = true;
+}
+
+const std::string& Burst::PlotWriter::getPath() const
+{
+	return path_;
+}
+
+Poco::UInt64 Burst::PlotWriter::getNoncesWritten() const
+{
+	return noncesWritten_.load();
+}
+
+std::string Burst::PlotWriter::getFileName(const Poco::UInt64 account, const Poco::UInt64 startNonce, const Poco::UInt64 nonces)
+{
+	return std::to_string(account) + "_" + std::to_string(startNonce) + "_" + std::to_string(nonces);
+}
+
+bool Burst::PlotWriter::isProgress(const std::string& path)
+{
+	const std::string suffix = ":stream";
+	return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool Burst::PlotWriter::writeGroup(const PlotFileHandle& file, const char* staging, const Poco::UInt64 group,
+	const Poco::UInt64 nonces) const
+{
+	// the nonces of the group are one contiguous block inside every scoop of the file
+	const auto size = nonces * Settings::ScoopSize;
+
+	for (size_t scoop = 0; scoop < Settings::ScoopPerPlot; ++scoop)
+	{
+		const auto offset = (scoop * nonces_ + group) * Settings::ScoopSize;
+
+		if (file.write(staging + scoop * size, size, offset) != static_cast<Poco::Int64>(size))
+			return false;
+	}
+
+	return true;
+}
+
+bool Burst::PlotWriter::readProgress(Poco::UInt64& noncesWritten) const
+{
+	std::ifstream stream{path_ + ":stream", std::ios::binary};
+	return stream && stream.read(reinterpret_cast<char*>(&noncesWritten), sizeof noncesWritten);
+}
+
+bool Burst::PlotWriter::writeProgress(const Poco::UInt64 noncesWritten) const
+{
+	std::ofstream stream{path_ + ":stream", std::ios::binary | std::ios::trunc};
+	stream.write(reinterpret_cast<const char*>(&noncesWritten), sizeof noncesWritten);
+	stream.flush();
+	return static_cast<bool>(stream);
+}
+
+void Burst::PlotWriter::removeProgress() const
+{
+	try
+	{
+		Poco::File{path_ + ":stream"}.remove();
+	}
+	catch (Poco::Exception& exc)
+	{
+		log_debug(MinerLogger::general, "Could not remove the progress of the plot file %s: %s", path_, exc.displayText());
+	}
+}
@@ -0,0 +1,117 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <atomic>
+#include <string>
+#include "Declarations.hpp"
+#include "BufferArena.hpp"
+
+namespace Burst
+{
+	class PlotFileHandle;
+
+	/**
+	 * \brief Plots an optimized PoC2 plot file (account_startnonce_nonces).
+	 * A pool of threads generates the nonces with the SIMD kernels of the plot generator into a scoop-major
+	 * staging buffer, while the previous buffer is written into the file.
+	 * The written nonces are stored in the :stream of the file, so an interrupted plot file is resumed.
+	 */
+	class PlotWriter
+	{
+	public:
+		/**
+		 * \brief The nonces of every staging buffer are a multiple of this,
+		 * so every block of a scoop is aligned for direct writes.
+		 */
+		static constexpr Poco::UInt64 NonceAlignment = BufferArena::Alignment / Settings::ScoopSize;
+
+		/**
+		 * \param dir The directory of the plot file.
+		 * \param account The numeric account id.
+		 * \param startNonce The first nonce.
+		 * \param nonces The amount of nonces.
+		 */
+		PlotWriter(const std::string& dir, Poco::UInt64 account, Poco::UInt64 startNonce, Poco::UInt64 nonces);
+
+		/**
+		 * \brief Sets the amount of generator threads (0 = all cores).
+		 */
+		void setThreads(size_t threads);
+
+		/**
+		 * \brief Sets the instruction set of the plot generator (AUTO = the fastest one).
+		 */
+		void setInstructionSet(const std::string& instructionSet);
+
+		/**
+		 * \brief Sets the memory of both staging buffers in bytes.
+		 */
+		void setMaxMemory(Poco::UInt64 maxMemory);
+
+		/**
+		 * \brief If true, the file is written directly (unbuffered), when the file system supports it.
+		 */
+		void setDirect(bool direct);
+
+		/**
+		 * \brief Plots the file or the rest of it (blocking).
+		 * \return true, if the plot file is complete.
+		 */
+		bool run();
+
+		/**
+		 * \brief Stops the plotting after the current staging buffer, it can be resumed later.
+		 */
+		void cancel();
+
+		const std::string& getPath() const;
+		Poco::UInt64 getNoncesWritten() const;
+
+		/**
+		 * \brief Returns the name of an optimized PoC2 plot file.
+		 */
+		static std::string getFileName(Poco::UInt64 account, Poco::UInt64 startNonce, Poco::UInt64 nonces);
+
+		/**
+		 * \brief Returns true, if the path is the progress of a plot file, that is written.
+		 * On systems without alternate data streams the :stream is a file next to the plot file.
+		 */
+		static bool isProgress(const std::string& path);
+
+	private:
+		bool writeGroup(const PlotFileHandle& file, const char* staging, Poco::UInt64 group, Poco::UInt64 nonces) const;
+		bool readProgress(Poco::UInt64& noncesWritten) const;
+		bool writeProgress(Poco::UInt64 noncesWritten) const;
+		void removeProgress() const;
+
+		std::string path_;
+		Poco::UInt64 account_, startNonce_, nonces_;
+		size_t threads_ = 0;
+		std::string instructionSet_ = "AUTO";
+		Poco::UInt64 maxMemory_ = 1024 * 1024 * 1024;
+		bool direct_ = true;
+		std::atomic<Poco::UInt64> noncesWritten_{0};
+		std::atomic<bool> cancelled_{false};
+	};
+}
@@ -0,0 +1,259 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "VerificationQueue.hpp"
+#include "PlotVerifier.hpp"
+#include <algorithm>
+#include <limits>
+
+constexpr size_t Burst::VerificationQueue::MaxWorkers;
+constexpr size_t Burst::VerificationQueue::DefaultSplitSize;
+
+Burst::VerificationQueue::VerificationQueue()
+{
+	deques_.reserve(MaxWorkers);
+
+	for (size_t i = 0; i < MaxWorkers; ++i)
+		deques_.emplace_back(new WorkerDeque);
+}
+
+Burst::VerificationQueue::~VerificationQueue() = default;
+
+size_t Burst::VerificationQueue::addWorker(const size_t node, const size_t splitSize)
+{
+	const auto worker = workers_++ % MaxWorkers;
+	auto& deque = *deques_[worker];
+	deque.node = node;
+	deque.splitSize = splitSize;
+	deque.activeScoops = 0;
+	deque.throughput = 0;
+	return worker;
+}
+
+void Burst::VerificationQueue::resetWorkers()
+{
+	// the work of the old verifiers is taken by the new ones
+	auto& first = *deques_.front();
+	std::lock_guard<std::mutex> firstLock{first.mutex};
+
+	for (size_t i = 1; i < deques_.size(); ++i)
+	{
+		auto& deque = *deques_[i];
+		std::lock_guard<std::mutex> lock{deque.mutex};
+		std::move(deque.works.begin(), deque.works.end(), std::back_inserter(first.works));
+		first.queuedScoops += deque.queuedScoops;
+		deque.works.clear();
+		deque.queuedScoops = 0;
+		deque.node = 0;
+	}
+
+	first.node = 0;
+	workers_ = 0;
+	nextDeque_ = 0;
+}
+
+void Burst::VerificationQueue::enqueue(Poco::AutoPtr<VerifyNotification> notification, const size_t node)
+{
+	VerificationWork work;
+	work.size = notification->bufferSize;
+	work.notification = std::move(notification);
+
+	push(findWorker(node, work.size), std::move(work));
+}
+
+bool Burst::VerificationQueue::waitDequeue(const size_t worker, VerificationWork& work)
+{
+	while (true)
+	{
+		if (tryDequeue(worker, work))
+			return true;
+
+		std::unique_lock<std::mutex> lock{sleepMutex_};
+		const auto wakeUps = wakeUps_;
+
+		// the sleeper is counted before the size is checked,
+		// so a producer either sees the sleeper or the sleeper sees the new work
+		++sleepers_;
+
+		condition_.wait(lock, [this, wakeUps]()
+		{
+			return size_ > 0 || wakeUps != wakeUps_;
+		});
+
+		--sleepers_;
+
+		if (wakeUps != wakeUps_)
+			return false;
+	}
+}
+
+void Burst::VerificationQueue::finishWork(const size_t worker, const VerificationWork& work, const double seconds)
+{
+	auto& deque = *deques_[worker % MaxWorkers];
+	deque.activeScoops = 0;
+
+	// an interrupted verification says nothing about the throughput
+	if (seconds <= 0)
+		return;
+
+	const auto measured = work.size / seconds;
+	const auto throughput = deque.throughput.load();
+
+	deque.throughput = throughput > 0 ? throughput * 0.75 + measured * 0.25 : measured;
+}
+
+double Burst::VerificationQueue::getThroughput(const size_t worker) const
+{
+	return deques_[worker % MaxWorkers]->throughput;
+}
+
+void Burst::VerificationQueue::wakeUpAll()
+{
+	{
+		std::lock_guard<std::mutex> lock{sleepMutex_};
+		++wakeUps_;
+	}
+
+	condition_.notify_all();
+}
+
+size_t Burst::VerificationQueue::size() const
+{
+	return size_;
+}
+
+bool Burst::VerificationQueue::tryDequeue(const size_t worker, VerificationWork& work)
+{
+	const auto workers = std::max<size_t>(std::min(workers_.load(), MaxWorkers), 1);
+	auto& own = *deques_[worker % MaxWorkers];
+
+	// the own work from the front, the work of the others from the back
+	auto found = pop(own, true, work);
+
+	for (size_t i = 1; i <= workers && !found; ++i)
+		found = pop(*deques_[(worker + i) % workers], false, work);
+
+	if (!found)
+		return false;
+
+	--size_;
+
+	// the rest of a big chunk is put back, so that idle verifiers can steal it
+	const auto splitSize = own.splitSize.load();
+
+	if (splitSize > 0 && work.size > splitSize)
+	{
+		VerificationWork rest;
+		rest.notification = work.notification;
+		rest.offset = work.offset + splitSize;
+		rest.size = work.size - splitSize;
+		work.size = splitSize;
+
+		work.notification->addPart();
+		push(worker, std::move(rest));
+	}
+
+	own.activeScoops = work.size;
+	return true;
+}
+
+bool Burst::VerificationQueue::pop(WorkerDeque& deque, const bool front, VerificationWork& work)
+{
+	std::lock_guard<std::mutex> lock{deque.mutex};
+
+	if (deque.works.empty())
+		return false;
+
+	if (front)
+	{
+		work = std::move(deque.works.front());
+		deque.works.pop_front();
+	}
+	else
+	{
+		work = std::move(deque.works.back());
+		deque.works.pop_back();
+	}
+
+	deque.queuedScoops -= work.size;
+	return true;
+}
+
+void Burst::VerificationQueue::push(const size_t worker, VerificationWork work)
+{
+	{
+		auto& deque = *deques_[worker % MaxWorkers];
+		std::lock_guard<std::mutex> lock{deque.mutex};
+		deque.queuedScoops += work.size;
+		deque.works.emplace_back(std::move(work));
+	}
+
+	++size_;
+
+	if (sleepers_ > 0)
+	{
+		std::lock_guard<std::mutex> lock{sleepMutex_};
+		condition_.notify_one();
+	}
+}
+
+size_t Burst::VerificationQueue::findWorker(const size_t node, const size_t scoops)
+{
+	const auto workers = std::min(workers_.load(), MaxWorkers);
+
+	if (workers == 0)
+		return 0;
+
+	// only the verifiers on the node of the chunk, if there are any
+	auto onNode = false;
+
+	for (size_t i = 0; i < workers && !onNode; ++i)
+		onNode = deques_[i]->node == node;
+
+	// the verifier, that is expected to finish the chunk first;
+	// the search starts round robin, so equal verifiers get the chunks in turns
+	const auto start = nextDeque_++;
+	auto best = start % workers;
+	auto bestTime = std::numeric_limits<double>::max();
+
+	for (size_t i = 0; i < workers; ++i)
+	{
+		const auto candidate = (start + i) % workers;
+		const auto& deque = *deques_[candidate];
+
+		if (onNode && deque.node != node)
+			continue;
+
+		// a verifier, that was not measured yet, gets the chunk, so it is measured
+		const auto throughput = deque.throughput.load();
+		const auto time = throughput > 0
+			? static_cast<double>(deque.queuedScoops + deque.activeScoops + scoops) / throughput
+			: 0.0;
+
+		if (time < bestTime)
+		{
+			best = candidate;
+			bestTime = time;
+		}
+	}
+
+	return best;
+}
@@ -0,0 +1,154 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/AutoPtr.h>
+#include <Poco/Types.h>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+namespace Burst
+{
+	struct VerifyNotification;
+
+	/**
+	 * \brief A range of scoops inside a read chunk, that is verified by one verifier.
+	 */
+	struct VerificationWork
+	{
+		Poco::AutoPtr<VerifyNotification> notification;
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	/**
+	 * \brief The work-stealing queue of the read chunks, that wait for their verification.
+	 * Every verifier owns a deque and takes the work from its front. An idle verifier steals from the
+	 * back of the other deques, so there is no lock, that is shared by all verifiers.
+	 * A chunk bigger than the split size is split, when it is taken, and the rest is put back,
+	 * where it can be stolen. So also the last chunks of a round are verified by all verifiers.
+	 * A new chunk is put into the deque of the verifier, that is expected to finish it first.
+	 * The expectation is based on the measured throughput of the verifier and the scoops in its deque,
+	 * so CPU and GPU verifiers can work on the same queue. Only the verifiers on the NUMA node
+	 * of the chunk are taken into account (if there are any).
+	 */
+	class VerificationQueue
+	{
+	public:
+		/**
+		 * \brief The maximal amount of verifiers with their own deque (the others share them).
+		 */
+		static constexpr size_t MaxWorkers = 256;
+
+		/**
+		 * \brief The default amount of scoops, that are verified at once.
+		 */
+		static constexpr size_t DefaultSplitSize = 16 * 1024;
+
+		VerificationQueue();
+		~VerificationQueue();
+
+		/**
+		 * \brief Adds a verifier.
+		 * \param node The NUMA node of the verifier.
+		 * \param splitSize The amount of scoops, that the verifier verifies at once (0 = whole chunks).
+		 * \return The index of the verifier, that is needed to take work.
+		 */
+		size_t addWorker(size_t node, size_t splitSize = DefaultSplitSize);
+
+		/**
+		 * \brief Removes all verifiers, their work stays in the queue.
+		 * Must only be called, while no verifier is running.
+		 */
+		void resetWorkers();
+
+		/**
+		 * \brief Puts a chunk into the deque of a verifier.
+		 * \param notification The chunk.
+		 * \param node The NUMA node, where the chunk was read.
+		 */
+		void enqueue(Poco::AutoPtr<VerifyNotification> notification, size_t node);
+
+		/**
+		 * \brief Waits for the next work of a verifier (its own or stolen from another verifier).
+		 * \param worker The index of the verifier.
+		 * \param work The work, that needs to be verified.
+		 * \return false, if the waiting verifiers are woken up.
+		 */
+		bool waitDequeue(size_t worker, VerificationWork& work);
+
+		/**
+		 * \brief Tells the queue, that a verifier finished its work.
+		 * \param worker The index of the verifier.
+		 * \param work The verified work.
+		 * \param seconds The time, the verification took.
+		 */
+		void finishWork(size_t worker, const VerificationWork& work, double seconds);
+
+		/**
+		 * \brief Returns the measured throughput of a verifier.
+		 * \param worker The index of the verifier.
+		 * \return The verified scoops per second (0, if nothing was verified yet).
+		 */
+		double getThroughput(size_t worker) const;
+
+		/**
+		 * \brief Wakes up all waiting verifiers.
+		 */
+		void wakeUpAll();
+
+		/**
+		 * \brief Returns the amount of waiting works.
+		 */
+		size_t size() const;
+
+	private:
+		struct WorkerDeque
+		{
+			std::deque<VerificationWork> works;
+			std::atomic<size_t> node{0};
+			std::atomic<size_t> splitSize{DefaultSplitSize};
+			std::atomic<size_t> queuedScoops{0};
+			std::atomic<size_t> activeScoops{0};
+			std::atomic<double> throughput{0};
+			std::mutex mutex;
+		};
+
+		bool tryDequeue(size_t worker, VerificationWork& work);
+		bool pop(WorkerDeque& deque, bool front, VerificationWork& work);
+		void push(size_t worker, VerificationWork work);
+		size_t findWorker(size_t node, size_t scoops);
+
+		std::vector<std::unique_ptr<WorkerDeque>> deques_;
+		std::atomic<size_t> workers_{0};
+		std::atomic<size_t> nextDeque_{0};
+		std::atomic<size_t> size_{0};
+		std::atomic<size_t> sleepers_{0};
+		Poco::UInt64 wakeUps_ = 0;
+		std::mutex sleepMutex_;
+		std::condition_variable condition_;
+	};
+}
@@ -0,0 +1,287 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#include "VerifierBenchmark.hpp"
+#include "PlotVerifier.hpp"
+#include "PlotGenerator.hpp"
+#include "MinerUtil.hpp"
+#include "logging/MinerLogger.hpp"
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <functional>
+
+namespace Burst
+{
+	namespace VerifierBenchmarkHelper
+	{
+		/**
+		 * \brief A base target of the size, that is common on the network.
+		 */
+		const Poco::UInt64 BaseTarget = 50000;
+
+		template <typename TAlgorithm>
+		VerifierBenchmark::Result measure(const ScoopData* buffer, const size_t scoops, const std::chrono::milliseconds minDuration)
+		{
+			GensigData gensig;
+			std::mt19937 random{42};
+
+			for (auto& byte : gensig)
+				byte = static_cast<unsigned char>(random());
+
+			const ShabalMidstates midstates{gensig};
+			const auto stop = []() { return false; };
+
+			VerifierBenchmark::Result result;
+			result.bufferSize = scoops;
+			void* stream = nullptr;
+
+			if (!TAlgorithm::initStream(&stream))
+			{
+				log_error(MinerLogger::general, "Could not create a verification stream for the benchmark");
+				return result;
+			}
+
+			Poco::UInt64 checksum = 0;
+			const auto startPoint = std::chrono::high_resolution_clock::now();
+			std::chrono::duration<double> elapsed{0};
+
+			do
+			{
+				checksum += TAlgorithm::run(buffer, scoops, result.scoops, 0, BaseTarget, 0, gensig, &midstates, stop, stream).first;
+				result.scoops += scoops;
+				elapsed = std::chrono::high_resolution_clock::now() - startPoint;
+			}
+			while (elapsed < minDuration);
+
+			result.seconds = elapsed.count();
+
+			// the checksum keeps the compiler from optimizing the verification away
+			if (checksum == 0 && scoops > 0)
+				log_debug(MinerLogger::general, "The benchmark of the verification found no deadline");
+
+			return result;
+		}
+
+		template <typename TGenerate>
+		VerifierBenchmark::Result measureGenerator(TGenerate generate, const std::chrono::milliseconds minDuration)
+		{
+			// the account and the nonces are arbitrary, every nonce takes the same time to generate
+			const Poco::UInt64 account = 12345678;
+
+			VerifierBenchmark::Result result;
+			Poco::UInt64 nonce = 0;
+			const auto startPoint = std::chrono::high_resolution_clock::now();
+			std::chrono::duration<double> elapsed{0};
+
+			do
+			{
+				const auto nonces = generate(account, nonce);
+				nonce += nonces;
+				result.bufferSize = nonces * Settings::ScoopPerPlot;
+				result.scoops += result.bufferSize;
+				elapsed = std::chrono::high_resolution_clock::now() - startPoint;
+			}
+			while (elapsed < minDuration);
+
+			result.seconds = elapsed.count();
+			return result;
+		}
+
+		/**
+		 * \brief Runs a measurement in several threads at the same time.
+		 * The scoops of all threads are summed up, the time is the one of the slowest thread.
+		 */
+		template <typename TMeasure>
+		VerifierBenchmark::Result measureParallel(const size_t threads, TMeasure measure)
+		{
+			std::vector<VerifierBenchmark::Result> results(std::max<size_t>(threads, 1));
+			std::vector<std::thread> workers;
+
+			for (auto& result : results)
+				workers.emplace_back([&result, &measure]() { result = measure(); });
+
+			for (auto& worker : workers)
+				worker.join();
+
+			auto total = results.front();
+			total.scoops = 0;
+			total.threads = results.size();
+
+			for (const auto& result : results)
+			{
+				total.scoops += result.scoops;
+				total.seconds = std::max(total.seconds, result.seconds);
+			}
+
+			return total;
+		}
+	}
+}
+
+double Burst::VerifierBenchmark::Result::getScoopsPerSecond() const
+{
+	return seconds > 0 ? scoops / seconds : 0;
+}
+
+double Burst::VerifierBenchmark::Result::getBytesPerSecond() const
+{
+	return getScoopsPerSecond() * Settings::ScoopSize;
+}
+
+double Burst::VerifierBenchmark::Result::getNanosecondsPerScoop() const
+{
+	return scoops > 0 ? seconds * 1e9 / scoops : 0;
+}
+
+bool Burst::VerifierBenchmark::Result::isValid() const
+{
+	return !instructionSet.empty() && scoops > 0;
+}
+
+std::vector<std::string> Burst::VerifierBenchmark::getAvailableInstructionSets()
+{
+	std::vector<std::string> instructionSets{"SSE2"};
+
+	if (Settings::Sse4 && cpuHasInstructionSet(CpuInstructionSet::sse4))
+		instructionSets.emplace_back("SSE4");
+
+	if (Settings::Avx && cpuHasInstructionSet(CpuInstructionSet::avx))
+		instructionSets.emplace_back("AVX");
+
+	if (Settings::Avx2 && cpuHasInstructionSet(CpuInstructionSet::avx2))
+		instructionSets.emplace_back("AVX2");
+
+	if (Settings::Avx512 && cpuHasInstructionSet(CpuInstructionSet::avx512f))
+		instructionSets.emplace_back("AVX512F");
+
+	return instructionSets;
+}
+
+bool Burst::VerifierBenchmark::isAvailable(const std::string& instructionSet)
+{
+	const auto instructionSets = getAvailableInstructionSets();
+	return std::find(instructionSets.begin(), instructionSets.end(), instructionSet) != instructionSets.end();
+}
+
+Burst::VerifierBenchmark::Result Burst::VerifierBenchmark::run(const std::string& instructionSet, const ScoopData* buffer,
+	const size_t scoops, const std::chrono::milliseconds minDuration)
+{
+	using namespace VerifierBenchmarkHelper;
+	Result result;
+
+	if (instructionSet == "SSE4" && Settings::Sse4)
+		result = measure<PlotVerifierAlgorithm_sse4>(buffer, scoops, minDuration);
+	else if (instructionSet == "AVX" && Settings::Avx)
+		result = measure<PlotVerifierAlgorithm_avx>(buffer, scoops, minDuration);
+	else if (instructionSet == "AVX2" && Settings::Avx2)
+		result = measure<PlotVerifierAlgorithm_avx2>(buffer, scoops, minDuration);
+	else if (instructionSet == "AVX512F" && Settings::Avx512)
+		result = measure<PlotVerifierAlgorithm_avx512>(buffer, scoops, minDuration);
+	else if (instructionSet == "CUDA" && Settings::Cuda)
+		result = measure<PlotVerifierAlgorithm_cuda>(buffer, scoops, minDuration);
+	else if (instructionSet == "OPENCL" && Settings::OpenCl)
+		result = measure<PlotVerifierAlgorithm_opencl>(buffer, scoops, minDuration);
+	else if (instructionSet == "SIMULATED_GPU")
+		result = measure<PlotVerifierAlgorithm_simulatedGpu>(buffer, scoops, minDuration);
+	else if (instructionSet == "SSE2")
+		result = measure<PlotVerifierAlgorithm_sse2>(buffer, scoops, minDuration);
+	// an unknown or not compiled algorithm is not measured, so the result is invalid
+	else
+		return result;
+
+	result.instructionSet = instructionSet;
+	return result;
+}
+
+Burst::VerifierBenchmark::Result Burst::VerifierBenchmark::run(const std::string& algorithm, const size_t scoops,
+	const size_t threads, const std::chrono::milliseconds minDuration)
+{
+	return VerifierBenchmarkHelper::measureParallel(threads, [&]()
+	{
+		// every thread creates its own buffer, so it is in the memory of its own NUMA node
+		const auto buffer = createSampleBuffer(scoops);
+		return run(algorithm, buffer.data(), buffer.size(), minDuration);
+	});
+}
+
+Burst::VerifierBenchmark::Result Burst::VerifierBenchmark::runGenerator(const std::string& instructionSet,
+	const size_t threads, const std::chrono::milliseconds minDuration)
+{
+	using namespace VerifierBenchmarkHelper;
+	std::function<size_t(Poco::UInt64, Poco::UInt64)> generate;
+
+	if (instructionSet == "SSE4" && Settings::Sse4)
+		generate = [](Poco::UInt64 account, Poco::UInt64 nonce) { return PlotGenerator::generateSse4(account, nonce).size(); };
+	else if (instructionSet == "AVX" && Settings::Avx)
+		generate = [](Poco::UInt64 account, Poco::UInt64 nonce) { return PlotGenerator::generateAvx(account, nonce).size(); };
+	else if (instructionSet == "AVX2" && Settings::Avx2)
+		generate = [](Poco::UInt64 account, Poco::UInt64 nonce) { return PlotGenerator::generateAvx2(account, nonce).size(); };
+	else if (instructionSet == "AVX512F" && Settings::Avx512)
+		generate = [](Poco::UInt64 account, Poco::UInt64 nonce) { return PlotGenerator::generateAvx512(account, nonce).size(); };
+	else if (instructionSet == "SSE2")
+		generate = [](Poco::UInt64 account, Poco::UInt64 nonce) { PlotGenerator::generateSse2(account, nonce); return size_t{1}; };
+	else
+		return Result{};
+
+	auto result = measureParallel(threads, [&]() { return measureGenerator(generate, minDuration); });
+	result.instructionSet = instructionSet;
+	return result;
+}
+
+std::string Burst::VerifierBenchmark::findFastestInstructionSet()
+{
+	// 1 MiB of scoops, it is small enough to stay in the cache, so only the kernel is measured
+	const auto buffer = createSampleBuffer(16 * 1024);
+	Result fastest;
+
+	for (const auto& instructionSet : getAvailableInstructionSets())
+	{
+		const auto result = run(instructionSet, buffer.data(), buffer.size(), std::chrono::milliseconds{50});
+
+		if (!result.isValid())
+		{
+			log_debug(MinerLogger::config, "CPU instruction set %s could not be measured", instructionSet);
+			continue;
+		}
+
+		log_debug(MinerLogger::config, "CPU instruction set %s verifies %s scoops/s", instructionSet,
+			numberToString(static_cast<Poco::UInt64>(result.getScoopsPerSecond())));
+
+		if (fastest.instructionSet.empty() || result.getScoopsPerSecond() > fastest.getScoopsPerSecond())
+			fastest = result;
+	}
+
+	// SSE2 is always compiled in and runs on every x86-64 CPU
+	return fastest.isValid() ? fastest.instructionSet : "SSE2";
+}
+
+std::vector<Burst::ScoopData> Burst::VerifierBenchmark::createSampleBuffer(const size_t scoops)
+{
+	std::vector<ScoopData> buffer(scoops);
+	std::mt19937 random{1337};
+
+	for (auto& scoop : buffer)
+		for (auto& byte : scoop)
+			byte = static_cast<unsigned char>(random());
+
+	return buffer;
+}
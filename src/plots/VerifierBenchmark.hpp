@@ -0,0 +1,112 @@
+// ==========================================================================
+// 
+// creepMiner - Burstcoin cryptocurrency CPU and GPU miner
+// Copyright (C)  2016-2018 Creepsky (creepsky@gmail.com)
+// 
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110 - 1301  USA
+// 
+// ==========================================================================
+
+#pragma once
+
+#include <Poco/Types.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Declarations.hpp"
+
+namespace Burst
+{
+	/**
+	 * \brief Measures the cpu verification kernels in isolation, on a buffer of synthetic scoops.
+	 * It is used to find the fastest instruction set at startup and by the benchmark tool.
+	 */
+	class VerifierBenchmark
+	{
+	public:
+		struct Result
+		{
+			std::string instructionSet;
+			Poco::UInt64 scoops = 0;
+			double seconds = 0.0;
+			Poco::UInt64 bufferSize = 0;
+			size_t threads = 1;
+
+			double getScoopsPerSecond() const;
+			double getBytesPerSecond() const;
+			double getNanosecondsPerScoop() const;
+
+			/**
+			 * \brief Returns true, if the algorithm is known and could be measured.
+			 */
+			bool isValid() const;
+		};
+
+		/**
+		 * \brief Returns the cpu instruction sets, that are compiled in and supported by the cpu.
+		 * The names are the ones of the config (SSE2, SSE4, AVX, AVX2, AVX512F).
+		 */
+		static std::vector<std::string> getAvailableInstructionSets();
+
+		/**
+		 * \brief Returns true, if an instruction set is compiled in and supported by the cpu.
+		 */
+		static bool isAvailable(const std::string& instructionSet);
+
+		/**
+		 * \brief Verifies a buffer of scoops again and again with the kernel of an instruction set.
+		 * \param instructionSet The instruction set, that needs to be available.
+		 * \param buffer The scoops.
+		 * \param scoops The amount of scoops in the buffer.
+		 * \param minDuration The buffer is verified until at least this time has passed.
+		 * \return The amount of verified scoops and the time needed for them.
+		 */
+		static Result run(const std::string& instructionSet, const ScoopData* buffer, size_t scoops,
+			std::chrono::milliseconds minDuration);
+
+		/**
+		 * \brief Verifies buffers of synthetic scoops in parallel, every thread on its own buffer.
+		 * \param algorithm The instruction set or the gpu processor type (CUDA, OPENCL, SIMULATED_GPU).
+		 * A gpu needs to be initialized before.
+		 * \param scoops The amount of scoops in every buffer.
+		 * \param threads The amount of threads.
+		 * \param minDuration Every thread verifies until at least this time has passed.
+		 * \return The amount of verified scoops of all threads and the time needed for them.
+		 */
+		static Result run(const std::string& algorithm, size_t scoops, size_t threads, std::chrono::milliseconds minDuration);
+
+		/**
+		 * \brief Generates nonces in parallel with the plot generator of an instruction set.
+		 * The scoops of the result are the scoops of the generated nonces.
+		 * \param instructionSet The instruction set, that needs to be available.
+		 * \param threads The amount of threads.
+		 * \param minDuration Every thread generates until at least this time has passed.
+		 * \return The amount of generated scoops of all threads and the time needed for them.
+		 */
+		static Result runGenerator(const std::string& instructionSet, size_t threads, std::chrono::milliseconds minDuration);
+
+		/**
+		 * \brief Measures all available instruction sets on a small sample buffer.
+		 * \return The instruction set with the most scoops per second.
+		 */
+		static std::string findFastestInstructionSet();
+
+		/**
+		 * \brief Creates a buffer of random scoops.
+		 * \param scoops The amount of scoops.
+		 */
+		static std::vector<ScoopData> createSampleBuffer(size_t scoops);
+	};
+}
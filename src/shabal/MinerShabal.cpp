@@ -20,3 +20,21 @@
 // ==========================================================================
 
 #include "MinerShabal.hpp"
+
+Burst::ShabalMidstates::ShabalMidstates(const GensigData& gensig)
+	: gensig_{gensig}
+{}
+
+void Burst::ShabalMidstates::warmUp(const std::string& cpuInstructionSet) const
+{
+	if (cpuInstructionSet == "SSE4" && Settings::Sse4)
+		get<Shabal256_SSE4>();
+	else if (cpuInstructionSet == "AVX" && Settings::Avx)
+		get<Shabal256_AVX>();
+	else if (cpuInstructionSet == "AVX2" && Settings::Avx2)
+		get<Shabal256_AVX2>();
+	else if (cpuInstructionSet == "AVX512F" && Settings::Avx512)
+		get<Shabal256_AVX512>();
+	else if (cpuInstructionSet == "SSE2")
+		get<Shabal256_SSE2>();
+}
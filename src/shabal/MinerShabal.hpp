@@ -22,12 +22,17 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
 
+#include "shabal/impl/mshabal_avx512f_impl.hpp"
 #include "shabal/impl/mshabal_avx2_impl.hpp"
 #include "shabal/impl/mshabal_avx_impl.hpp"
 #include "shabal/impl/mshabal_sse4_impl.hpp"
 #include "shabal/impl/sphlib_impl.hpp"
 #include <Poco/ByteOrder.h>
+#include "Declarations.hpp"
 
 namespace Burst
 {
@@ -64,8 +69,58 @@ namespace Burst
 		typename TAlgorithm::context_t context_;
 	};
 
+	using Shabal256_AVX512 = Shabal256_Shell<Mshabal_avx512f_Impl>;
 	using Shabal256_AVX2 = Shabal256_Shell<Mshabal_avx2_Impl>;
 	using Shabal256_AVX = Shabal256_Shell<Mshabal_avx_Impl>;
 	using Shabal256_SSE4 = Shabal256_Shell<Mshabal_sse4_Impl>;
 	using Shabal256_SSE2 = Shabal256_Shell<Sphlib_Impl>;
+
+	/**
+	 * \brief The states of the shabal contexts after the gensig of a block was hashed.
+	 * Every scoop hash of a block starts with the gensig, so the verifiers copy one of these
+	 * states instead of initializing a new context and hashing the gensig for every buffer.
+	 * The state of an instruction set is computed when it is needed for the first time,
+	 * so only the instruction sets, that are used (and supported by the cpu), are touched.
+	 */
+	class ShabalMidstates
+	{
+	public:
+		explicit ShabalMidstates(const GensigData& gensig);
+
+		/**
+		 * \brief Returns the state of the context after hashing the gensig.
+		 * The function is thread safe, the returned context must not be changed, but copied.
+		 */
+		template <typename TShabal>
+		const TShabal& get() const
+		{
+			auto& midstate = std::get<Midstate<TShabal>>(midstates_);
+
+			std::call_once(midstate.once, [this, &midstate]()
+			{
+				midstate.shabal.reset(new TShabal);
+				midstate.shabal->update(gensig_.data(), gensig_.size());
+			});
+
+			return *midstate.shabal;
+		}
+
+		/**
+		 * \brief Computes the state for a cpu instruction set ahead of the verifiers.
+		 * \param cpuInstructionSet The name of the instruction set (SSE2, SSE4, AVX, AVX2, AVX512F).
+		 */
+		void warmUp(const std::string& cpuInstructionSet) const;
+
+	private:
+		template <typename TShabal>
+		struct Midstate
+		{
+			std::once_flag once;
+			std::unique_ptr<TShabal> shabal;
+		};
+
+		GensigData gensig_;
+		mutable std::tuple<Midstate<Shabal256_SSE2>, Midstate<Shabal256_SSE4>, Midstate<Shabal256_AVX>,
+			Midstate<Shabal256_AVX2>, Midstate<Shabal256_AVX512>> midstates_;
+	};
 }
@@ -84,6 +84,7 @@ extern "C" {
 #endif
 
 #define MSHABAL256_FACTOR 2
+#define MSHABAL512_FACTOR 4
 
 	/*
 	* The context structure for a Shabal computation. Contents are
@@ -121,6 +122,34 @@ extern "C" {
 		unsigned out_size;
 	} mshabal256_context;
 
+	/*
+	* The context structure for a Shabal computation with sixteen parallel
+	* instances (AVX-512F). Contents are private. Such a structure should be
+	* allocated and released by the caller, in any memory area.
+	*/
+	typedef struct {
+		unsigned char buf0[64];
+		unsigned char buf1[64];
+		unsigned char buf2[64];
+		unsigned char buf3[64];
+		unsigned char buf4[64];
+		unsigned char buf5[64];
+		unsigned char buf6[64];
+		unsigned char buf7[64];
+		unsigned char buf8[64];
+		unsigned char buf9[64];
+		unsigned char buf10[64];
+		unsigned char buf11[64];
+		unsigned char buf12[64];
+		unsigned char buf13[64];
+		unsigned char buf14[64];
+		unsigned char buf15[64];
+		size_t ptr;
+		mshabal_u32 state[(12 + 16 + 16) * 4 * MSHABAL512_FACTOR];
+		mshabal_u32 Whigh, Wlow;
+		unsigned out_size;
+	} mshabal512_context;
+
 	/*
 	* Initialize a context structure. The output size must be a multiple
 	* of 32, between 32 and 512 (inclusive). The output size is expressed
@@ -142,6 +171,13 @@ extern "C" {
 	*/
 	void avx2_mshabal_init(mshabal256_context *sc, unsigned out_size);
 
+	/*
+	* Initialize a context structure. The output size must be a multiple
+	* of 32, between 32 and 512 (inclusive). The output size is expressed
+	* in bits.
+	*/
+	void avx512f_mshabal_init(mshabal512_context *sc, unsigned out_size);
+
 	/*
 	* Process some more data bytes; four chunks of data, pointed to by
 	* data0, data1, data2 and data3, are processed. The four chunks have
@@ -187,6 +223,18 @@ extern "C" {
 		const void *data4, const void *data5, const void *data6, const void *data7,
 		size_t len);
 
+	/*
+	* Process some more data bytes; sixteen chunks of data, pointed to by
+	* data0 to data15, are processed. The sixteen chunks have the same
+	* length of "len" bytes. The rules of avx2_mshabal() apply.
+	*/
+	void avx512f_mshabal(mshabal512_context *sc,
+		const void *data0, const void *data1, const void *data2, const void *data3,
+		const void *data4, const void *data5, const void *data6, const void *data7,
+		const void *data8, const void *data9, const void *data10, const void *data11,
+		const void *data12, const void *data13, const void *data14, const void *data15,
+		size_t len);
+
 	/*
 	* Terminate the Shabal computation incarnated by the provided context
 	* structure. "n" shall be a value between 0 and 7 (inclusive): this is
@@ -264,6 +312,21 @@ extern "C" {
 		void *dst0, void *dst1, void *dst2, void *dst3,
 		void *dst4, void *dst5, void *dst6, void *dst7);
 
+	/*
+	* Terminate the Shabal computation of the sixteen parallel instances.
+	* The rules of avx2_mshabal_close() apply.
+	*/
+	void avx512f_mshabal_close(mshabal512_context *sc,
+		unsigned ub0, unsigned ub1, unsigned ub2, unsigned ub3,
+		unsigned ub4, unsigned ub5, unsigned ub6, unsigned ub7,
+		unsigned ub8, unsigned ub9, unsigned ub10, unsigned ub11,
+		unsigned ub12, unsigned ub13, unsigned ub14, unsigned ub15,
+		unsigned n,
+		void *dst0, void *dst1, void *dst2, void *dst3,
+		void *dst4, void *dst5, void *dst6, void *dst7,
+		void *dst8, void *dst9, void *dst10, void *dst11,
+		void *dst12, void *dst13, void *dst14, void *dst15);
+
 #ifdef  __cplusplus
 }
 #endif